@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+#include <DHTesp.h>
+#include <soc/gpio_struct.h>
+
+#include "recurrence.h"
+
+// Compile-time hardware profiles.
+//
+// A profile fixes the pin map, display geometry, sensor type and alarm
+// capacity as template parameters, so the firmware for every variant comes
+// from the same source and anything derived from them (array sizes, GPIO
+// register/bit, framebuffer size) is a constant. The build env picks the
+// profile with a -DBOARD_* flag; see platformio.ini.
+
+template <uint8_t Buzzer, uint8_t Led,
+          uint8_t PbCancel, uint8_t PbOk, uint8_t PbUp, uint8_t PbDown,
+          uint8_t DhtPin, DHTesp::DHT_MODEL_t Sensor,
+          uint8_t ScreenWidth, uint8_t ScreenHeight, uint8_t Alarms>
+struct BoardProfile {
+  static constexpr uint8_t buzzer = Buzzer;
+  static constexpr uint8_t led = Led;
+  static constexpr uint8_t pb_cancel = PbCancel;
+  static constexpr uint8_t pb_ok = PbOk;
+  static constexpr uint8_t pb_up = PbUp;
+  static constexpr uint8_t pb_down = PbDown;
+  static constexpr uint8_t dht_pin = DhtPin;
+  static constexpr DHTesp::DHT_MODEL_t sensor = Sensor;
+
+  static constexpr int screen_width = ScreenWidth;
+  static constexpr int screen_height = ScreenHeight;
+  static constexpr int frame_bytes = ScreenWidth * ScreenHeight / 8;
+
+  static constexpr int n_alarms = Alarms;
+
+  static_assert(ScreenHeight % 8 == 0, "SSD1306 pages are 8 rows high");
+  static_assert(ScreenWidth >= 128 && ScreenHeight >= 64, "screen layouts need at least 128x64");
+  static_assert(Alarms >= 1 && Alarms <= MAX_RULES, "one schedule bit per alarm");
+  static_assert(PbCancel < 40 && PbOk < 40 && PbUp < 40 && PbDown < 40, "no such GPIO");
+
+  // GPIO36-39 (SENSOR_VP/VN) can read a short low glitch while Wi-Fi or the
+  // ADC is active (ESP32 errata 3.11); raw polling would see a button press
+  static constexpr bool glitch_free(uint8_t pin) { return pin < 36; }
+  static_assert(glitch_free(PbCancel) && glitch_free(PbOk) && glitch_free(PbUp) && glitch_free(PbDown),
+                "buttons must not use GPIO36-39");
+};
+
+// Active-low push button, read straight from the GPIO input register. The pin
+// is a template argument, so the register and bit are picked at compile time.
+template <uint8_t Pin>
+inline bool button_down() {
+  if constexpr (Pin < 32) {
+    return !(GPIO.in & (1UL << Pin));
+  } else {
+    return !(GPIO.in1.val & (1UL << (Pin - 32)));
+  }
+}
+
+// The original MedBox: ESP32 DOIT DevKit v1, DHT22, 128x64 OLED, 2 alarms
+using MedBoxDevkitV1 = BoardProfile<5, 15, 34, 32, 33, 35, 12, DHTesp::DHT22, 128, 64, 2>;
+
+// ESP32-DevKitC build with a DHT11 and room for 4 alarms
+using MedBoxDevkitC = BoardProfile<25, 2, 34, 35, 26, 27, 4, DHTesp::DHT11, 128, 64, 4>;
+
+#if defined(BOARD_MEDBOX_DEVKITC)
+using Board = MedBoxDevkitC;
+#else
+using Board = MedBoxDevkitV1;
+#endif
@@ -0,0 +1,96 @@
+#pragma once
+
+// Generated by tools/embed_dashboard.py from web/dashboard.html, do not edit.
+// 2866 bytes of HTML, served gzipped.
+
+const size_t dashboard_html_gz_len = 1404;
+const uint8_t dashboard_html_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x56, 0x6d, 0x8f, 0xdb, 0x36,
+  0x0c, 0xfe, 0x9e, 0x5f, 0xe1, 0xea, 0x5a, 0xc0, 0xee, 0x39, 0x8e, 0x9d, 0x5e, 0x83, 0xc0, 0x2f,
+  0x39, 0xac, 0x5d, 0x87, 0x6e, 0x58, 0x5f, 0xb0, 0x1e, 0x30, 0x0c, 0x45, 0x31, 0x28, 0x16, 0x6d,
+  0x6b, 0x67, 0x5b, 0x86, 0xa4, 0x5c, 0x92, 0xa6, 0xf9, 0xef, 0xa3, 0xfc, 0x92, 0xf8, 0xb2, 0x0e,
+  0x1b, 0x10, 0xc4, 0x32, 0x45, 0x3e, 0xa4, 0xc8, 0x87, 0x94, 0xe3, 0x27, 0x3f, 0x7e, 0x78, 0x7d,
+  0xf7, 0xc7, 0xc7, 0x37, 0x56, 0xa1, 0xab, 0x72, 0x35, 0x89, 0x87, 0x07, 0x50, 0x86, 0x8f, 0x0a,
+  0x34, 0xb5, 0xd2, 0x82, 0x4a, 0x05, 0x3a, 0x21, 0x1b, 0x9d, 0x4d, 0x97, 0x64, 0x10, 0xd7, 0xb4,
+  0x82, 0x84, 0x3c, 0x70, 0xd8, 0x36, 0x42, 0x6a, 0x62, 0xa5, 0xa2, 0xd6, 0x50, 0xa3, 0xda, 0x96,
+  0x33, 0x5d, 0x24, 0x0c, 0x1e, 0x78, 0x0a, 0xd3, 0xf6, 0xc5, 0xe5, 0x35, 0xd7, 0x9c, 0x96, 0x53,
+  0x95, 0xd2, 0x12, 0x92, 0xc0, 0x60, 0x68, 0xae, 0x4b, 0x58, 0xbd, 0x03, 0xf6, 0x4a, 0xec, 0xe2,
+  0x59, 0xf7, 0x36, 0x89, 0x95, 0xde, 0x9b, 0xe7, 0x5a, 0xb0, 0xfd, 0x21, 0x43, 0xc0, 0x69, 0x46,
+  0x2b, 0x5e, 0xee, 0x43, 0x45, 0x6b, 0x35, 0x55, 0x20, 0x79, 0x16, 0x55, 0x54, 0xe6, 0xbc, 0x0e,
+  0xfd, 0xa8, 0xa1, 0x8c, 0xf1, 0x3a, 0x0f, 0x03, 0xa8, 0xa2, 0x35, 0x4d, 0xef, 0x73, 0x29, 0x36,
+  0x35, 0x0b, 0xaf, 0x82, 0x20, 0x88, 0x52, 0x51, 0x0a, 0x19, 0x5e, 0x01, 0x00, 0xea, 0xef, 0xba,
+  0x28, 0xc2, 0x1b, 0x1f, 0xaa, 0xe3, 0xa4, 0x08, 0x3a, 0x64, 0xc5, 0xbf, 0x42, 0x18, 0x78, 0x73,
+  0xb4, 0x1e, 0x20, 0x2d, 0xdf, 0xf2, 0x5e, 0x1a, 0x1d, 0x2f, 0x2d, 0x45, 0x7a, 0x3f, 0xd2, 0x7b,
+  0x81, 0x5a, 0xe3, 0x78, 0x2a, 0x51, 0x0b, 0xd5, 0xd0, 0x14, 0x50, 0x57, 0x8a, 0xed, 0x81, 0x71,
+  0xd5, 0x94, 0x74, 0x1f, 0x66, 0x25, 0xec, 0xa2, 0x9c, 0x36, 0x6d, 0x50, 0x3d, 0xac, 0x81, 0xb4,
+  0x7c, 0x03, 0x4a, 0x25, 0x3b, 0x8c, 0x23, 0x9d, 0xcf, 0xe7, 0xd1, 0x5a, 0x48, 0x06, 0x72, 0x2a,
+  0x29, 0xe3, 0x1b, 0x15, 0x2e, 0x9a, 0xdd, 0xe9, 0x5c, 0xde, 0x02, 0xed, 0x0c, 0x8e, 0x01, 0x0d,
+  0x83, 0x1e, 0xc0, 0x5a, 0x9f, 0x9c, 0xad, 0x4d, 0x90, 0xd1, 0xf8, 0x30, 0x8b, 0x36, 0xf8, 0x2d,
+  0x95, 0xf5, 0xa1, 0xcf, 0x40, 0xb6, 0x58, 0x1c, 0x27, 0x9a, 0xae, 0x4b, 0x38, 0x74, 0x49, 0x08,
+  0x7c, 0xff, 0xd9, 0xe0, 0x14, 0x75, 0x4a, 0xda, 0x28, 0x08, 0x87, 0x05, 0xaa, 0xb2, 0xc3, 0xc9,
+  0xff, 0xbc, 0x8b, 0x3b, 0xa5, 0xf5, 0x03, 0x55, 0x63, 0xf3, 0x02, 0x78, 0x5e, 0xe8, 0x30, 0xb8,
+  0xf1, 0x31, 0xdc, 0xff, 0x3c, 0xd0, 0x71, 0x72, 0xa5, 0x34, 0xd5, 0x1b, 0x35, 0xca, 0xa7, 0xb7,
+  0xc4, 0x73, 0xf5, 0x21, 0x2e, 0x97, 0xcb, 0xe3, 0x24, 0x9e, 0xf5, 0xa5, 0x8f, 0x67, 0x3d, 0xf7,
+  0x0c, 0x07, 0x0c, 0x13, 0x83, 0x9e, 0x24, 0x56, 0x8c, 0x09, 0xaf, 0x2d, 0xce, 0x12, 0xd2, 0xc1,
+  0x91, 0x15, 0x52, 0xae, 0x86, 0x54, 0x63, 0xb0, 0x9e, 0xe7, 0x21, 0x02, 0xee, 0xaf, 0xd0, 0x3e,
+  0x40, 0x33, 0xc6, 0x1f, 0xac, 0xb4, 0xa4, 0x4a, 0x25, 0xa4, 0xad, 0x25, 0x69, 0x0d, 0xbb, 0xe5,
+  0x6a, 0x3a, 0x0d, 0xdb, 0x5f, 0x3c, 0x43, 0xb5, 0x5e, 0xd9, 0x6c, 0x33, 0xaa, 0x81, 0xac, 0xc6,
+  0xd2, 0x1e, 0x02, 0x4b, 0x4c, 0x2e, 0x40, 0xb1, 0x14, 0x64, 0x75, 0x07, 0x55, 0x03, 0x12, 0x83,
+  0x91, 0x10, 0xaf, 0x5b, 0x08, 0x8d, 0x12, 0xe3, 0x20, 0x9e, 0xad, 0xbf, 0x07, 0xd4, 0x99, 0xbd,
+  0xdd, 0x54, 0x9c, 0x71, 0xbd, 0xef, 0x6d, 0x8a, 0x4d, 0x75, 0x69, 0xf2, 0x6f, 0x96, 0x93, 0x1f,
+  0x4a, 0x2a, 0x2b, 0x35, 0xca, 0x05, 0x35, 0x82, 0x3f, 0xa1, 0x36, 0x71, 0xb7, 0x09, 0x18, 0xe7,
+  0xa9, 0x16, 0xe2, 0x2b, 0x9c, 0x76, 0xb0, 0xe9, 0x0c, 0x11, 0xce, 0x66, 0xca, 0x6c, 0xb5, 0xb2,
+  0xb3, 0x4b, 0xcc, 0xde, 0x5b, 0xae, 0xb4, 0x90, 0xfb, 0x3e, 0x93, 0x5d, 0xf9, 0xbb, 0x40, 0x71,
+  0x83, 0x58, 0x5d, 0x7f, 0x93, 0x85, 0xef, 0x13, 0xab, 0x63, 0x42, 0x42, 0x90, 0x0a, 0x06, 0xab,
+  0xd3, 0x35, 0x7d, 0x9c, 0x4a, 0xde, 0xe8, 0xd5, 0xe4, 0x81, 0x4a, 0x4b, 0x25, 0x87, 0xa3, 0x6b,
+  0x4c, 0x93, 0xcf, 0x5f, 0xa2, 0x49, 0xb6, 0xa9, 0xb1, 0x62, 0xa2, 0xb6, 0x9e, 0xda, 0xdc, 0x39,
+  0x48, 0xc0, 0xdc, 0xd5, 0x16, 0x13, 0xe9, 0xa6, 0xc2, 0xe1, 0xe1, 0xe5, 0xa0, 0xdf, 0x94, 0x60,
+  0x96, 0xaf, 0xf6, 0x3f, 0x33, 0xd4, 0x38, 0x9e, 0x0d, 0x9a, 0xb9, 0x5d, 0x0f, 0x16, 0x76, 0x1d,
+  0x07, 0xfe, 0x2d, 0xf1, 0x49, 0x48, 0x88, 0x73, 0x5d, 0x8f, 0xb4, 0x24, 0xd4, 0x48, 0x3f, 0xdb,
+  0x39, 0x4c, 0x2c, 0x9e, 0xd9, 0xaa, 0xeb, 0x64, 0xe7, 0xa9, 0xdd, 0xd7, 0xde, 0xf1, 0x34, 0xec,
+  0xf4, 0xeb, 0x7e, 0x56, 0xf5, 0xdb, 0x51, 0xaf, 0x6b, 0xea, 0x6f, 0x54, 0x5b, 0x1e, 0x5c, 0x6a,
+  0x1a, 0xe1, 0xa0, 0x68, 0xaa, 0xfc, 0x24, 0xa9, 0x37, 0x65, 0xe9, 0x1c, 0x50, 0xbf, 0x2d, 0xfa,
+  0xa5, 0xbe, 0x11, 0x7a, 0x5a, 0xfc, 0xc4, 0x77, 0xc0, 0xec, 0xc0, 0xb9, 0x26, 0xd6, 0x6b, 0x12,
+  0x9d, 0x95, 0xdb, 0xb2, 0xbe, 0x37, 0x33, 0xb4, 0xc7, 0x8b, 0xe7, 0x37, 0xdf, 0xbe, 0x75, 0xcb,
+  0xd5, 0x8b, 0xb9, 0x73, 0x4b, 0x4c, 0x1b, 0x9b, 0xf3, 0x1d, 0x7b, 0xa7, 0x48, 0x93, 0x91, 0x4f,
+  0x43, 0x9a, 0x4b, 0x97, 0x28, 0x3b, 0x79, 0xf4, 0x8d, 0xc7, 0x67, 0xad, 0xc7, 0x4e, 0xf5, 0x91,
+  0x43, 0x14, 0xc5, 0x8b, 0x97, 0xc6, 0x1f, 0xae, 0x56, 0x4b, 0xff, 0x3b, 0xee, 0x06, 0x62, 0xf5,
+  0x3e, 0x11, 0xe7, 0x44, 0xb5, 0x4b, 0xbf, 0xc3, 0xc6, 0x2d, 0xb1, 0xa1, 0x36, 0x74, 0x62, 0x0e,
+  0x22, 0xd9, 0x38, 0xa7, 0xfa, 0x17, 0xcc, 0x1b, 0xda, 0xf7, 0x74, 0xbc, 0xb4, 0xee, 0xc4, 0xb7,
+  0x64, 0x6a, 0x75, 0x2b, 0x66, 0x91, 0x6b, 0xac, 0xf5, 0x3b, 0xaa, 0x0b, 0x2f, 0x2b, 0x85, 0x90,
+  0xf6, 0xa0, 0x33, 0x5b, 0xf8, 0x0e, 0x1e, 0x2b, 0x6c, 0xf7, 0x07, 0xe1, 0x33, 0x14, 0x62, 0xd8,
+  0xd1, 0x38, 0x6c, 0xe5, 0x1c, 0x0c, 0xf3, 0x90, 0xa5, 0x24, 0x1a, 0x44, 0x5e, 0x26, 0xe4, 0x1b,
+  0x9a, 0x16, 0xf6, 0x40, 0x15, 0x9b, 0xba, 0xdc, 0xd0, 0xc4, 0x2a, 0xae, 0x13, 0x12, 0x6b, 0xb9,
+  0x8a, 0x35, 0x5b, 0xb5, 0xfd, 0x85, 0x01, 0xd8, 0xfc, 0xda, 0xd4, 0x0c, 0xdb, 0x83, 0xb5, 0xf2,
+  0xd6, 0x25, 0xf5, 0x8a, 0x93, 0x7b, 0xea, 0x55, 0x8f, 0xf7, 0xa9, 0x27, 0xa1, 0x79, 0x24, 0x41,
+  0x1d, 0x2d, 0x79, 0x7e, 0x4b, 0xcc, 0x7f, 0x0e, 0x12, 0x18, 0xda, 0x6e, 0x29, 0x37, 0x03, 0x8b,
+  0x9c, 0x8c, 0x67, 0xe8, 0x99, 0x1c, 0x1d, 0x8c, 0xdf, 0x1a, 0x72, 0xac, 0x30, 0x47, 0x1c, 0x47,
+  0x9b, 0x7c, 0x7b, 0xf7, 0xee, 0xd7, 0xa4, 0x38, 0x4e, 0x46, 0xfc, 0x66, 0x92, 0x6e, 0x4d, 0x83,
+  0xb6, 0x0c, 0x37, 0x87, 0x4c, 0x13, 0x53, 0x62, 0xd3, 0x99, 0x8e, 0x9b, 0x27, 0xa9, 0x69, 0xa1,
+  0x36, 0xb7, 0x3b, 0x6d, 0x93, 0x39, 0x43, 0xe1, 0x16, 0x85, 0xdd, 0x35, 0x5c, 0xe0, 0xaa, 0xeb,
+  0xd8, 0x28, 0x47, 0x3e, 0x00, 0x95, 0xbf, 0xe1, 0xf8, 0xb4, 0x7d, 0xd7, 0x77, 0xb7, 0x6e, 0xe1,
+  0x74, 0x29, 0x34, 0x50, 0x5e, 0x09, 0x75, 0xae, 0x8b, 0x78, 0xee, 0x74, 0xed, 0x86, 0x3b, 0xa7,
+  0x00, 0x4a, 0x5e, 0x83, 0x7d, 0xef, 0x96, 0x02, 0x7b, 0xda, 0xc5, 0x11, 0xee, 0x1c, 0x72, 0x4f,
+  0x69, 0x29, 0xee, 0xe1, 0x93, 0x99, 0xe0, 0x09, 0x8a, 0x10, 0x7d, 0x0d, 0x78, 0xf5, 0x7d, 0xc4,
+  0x12, 0xda, 0x4e, 0xd4, 0x22, 0xfe, 0x23, 0xfb, 0x4d, 0x9f, 0x7d, 0x73, 0x86, 0x5d, 0xc2, 0x9f,
+  0x6f, 0x67, 0x63, 0xd7, 0xd3, 0xc0, 0x71, 0xf7, 0x49, 0x31, 0xb5, 0x9b, 0xcf, 0xf7, 0x5f, 0xa6,
+  0xa5, 0x70, 0xcc, 0xae, 0x79, 0x3e, 0x2f, 0x22, 0x7e, 0x9b, 0x7b, 0x26, 0x8a, 0x3b, 0x61, 0xef,
+  0xdc, 0xbd, 0x13, 0xe6, 0x5e, 0x25, 0x1e, 0x86, 0x37, 0xcc, 0xe4, 0x10, 0x8f, 0x8d, 0xd3, 0xa3,
+  0x0b, 0xd7, 0x77, 0x83, 0x97, 0xee, 0x8d, 0xef, 0x92, 0xab, 0x6c, 0x79, 0x43, 0x9c, 0xa8, 0x15,
+  0x06, 0xee, 0x0b, 0x94, 0xfb, 0x46, 0x7a, 0x43, 0x33, 0x94, 0x8e, 0xd3, 0x5c, 0x0a, 0xca, 0xfa,
+  0x34, 0x67, 0xa0, 0x31, 0x6e, 0x32, 0x2b, 0xba, 0xb1, 0xe8, 0xfd, 0xa5, 0x44, 0xdb, 0x02, 0x05,
+  0xd4, 0xe7, 0xd3, 0xc8, 0xd3, 0x2c, 0x93, 0xad, 0x02, 0xfa, 0xbe, 0x54, 0x61, 0xce, 0xa1, 0x9d,
+  0x82, 0x2c, 0x3a, 0xd7, 0xf0, 0x38, 0x1e, 0x70, 0xfd, 0x75, 0x76, 0xaa, 0xec, 0x56, 0x25, 0x35,
+  0x6c, 0xad, 0xdf, 0x61, 0xfd, 0x09, 0x87, 0x14, 0x60, 0x3d, 0xb7, 0x2a, 0x9c, 0xcd, 0xc8, 0x35,
+  0xce, 0x2c, 0x6a, 0x2c, 0xbc, 0x42, 0x28, 0x7d, 0x4d, 0x66, 0x5b, 0x65, 0xa2, 0x47, 0x7d, 0x0f,
+  0x3f, 0x4b, 0x1a, 0xa8, 0x93, 0x93, 0xcf, 0x76, 0x54, 0xf4, 0xd7, 0xe5, 0xe3, 0xbe, 0x23, 0x25,
+  0x7f, 0x00, 0x12, 0x9d, 0xcf, 0x79, 0x1c, 0x10, 0x70, 0x24, 0x2a, 0xf8, 0x5f, 0x10, 0x22, 0xcb,
+  0x4c, 0x26, 0xb1, 0xc7, 0x40, 0xdf, 0xf1, 0x0a, 0xc4, 0x46, 0xdb, 0xfd, 0x21, 0x30, 0xb7, 0xbe,
+  0x7f, 0xc6, 0xac, 0x40, 0x29, 0x9a, 0x8f, 0x50, 0xa1, 0xeb, 0x50, 0x96, 0xfc, 0xf2, 0xe9, 0xc3,
+  0x7b, 0xaf, 0x31, 0x5f, 0x98, 0x36, 0x98, 0x19, 0x4b, 0x1d, 0xfc, 0xa2, 0x91, 0xb6, 0xd9, 0xbc,
+  0xb7, 0x38, 0xf2, 0xdd, 0x51, 0xc8, 0x80, 0x84, 0xe1, 0x9f, 0x69, 0x11, 0x24, 0x28, 0xf3, 0x14,
+  0xad, 0x9a, 0x12, 0xba, 0x74, 0x7a, 0xcd, 0x46, 0x15, 0x67, 0x59, 0xf4, 0x98, 0xc1, 0xab, 0xf9,
+  0x72, 0xe9, 0xb4, 0xef, 0xaa, 0xe0, 0x19, 0x9e, 0x72, 0x9c, 0x7b, 0x84, 0x1b, 0x6e, 0x8b, 0xa3,
+  0x29, 0xfe, 0x29, 0xff, 0x91, 0xf9, 0x1c, 0xe9, 0x6f, 0x30, 0xbc, 0x95, 0xbb, 0x0f, 0x91, 0x59,
+  0xf7, 0x69, 0xfc, 0x37, 0xa9, 0x87, 0xac, 0xa7, 0x32, 0x0b, 0x00, 0x00,
+};
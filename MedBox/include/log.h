@@ -0,0 +1,145 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+
+// Buffered, leveled logging.
+//
+// LOG_E/W/I/D never touch the UART. A message is formatted into a slot of a
+// lock-free ring (bounded MPMC queue, safe from any task) and a background
+// task drains the ring to Serial at LOG_BAUD. If the ring is full the message
+// is dropped and counted, so the caller never stalls.
+//
+// Levels above LOG_LEVEL compile to nothing. Build with -DLOG_BINARY=1 to send
+// compact frames instead of text: a 32-bit hash of the format string plus the
+// raw arguments, decoded on the host by tools/log_decode.py.
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#ifndef LOG_BINARY
+#define LOG_BINARY 0
+#endif
+
+#define LOG_BAUD      921600
+#define LOG_SLOTS     32        // power of two
+#define LOG_SLOT_SIZE 96
+
+// Binary frame: sync, length of the rest, level, token, millis, arguments
+#define LOG_FRAME_SYNC   0xA5
+#define LOG_FRAME_HEADER 11
+#define LOG_TOKEN_DROPPED 0     // "%u log messages dropped"
+
+struct LogSlot {
+  std::atomic<uint32_t> seq;
+  uint8_t len;
+  uint8_t data[LOG_SLOT_SIZE];
+};
+
+void log_begin();
+void log_flush();   // wait until everything queued so far is on the wire
+
+bool log_reserve(LogSlot *&slot, uint32_t &pos);
+void log_commit(LogSlot *slot, uint32_t pos);
+
+void log_text(uint8_t level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// FNV-1a of the format string, shared with tools/log_decode.py
+constexpr uint32_t log_token(const char *s, uint32_t hash = 2166136261u) {
+  return *s ? log_token(s + 1, (hash ^ (uint8_t)*s) * 16777619u) : hash;
+}
+
+template <typename T>
+inline void log_pack_bytes(uint8_t *&p, uint8_t *end, const T &value) {
+  if (end - p < (ptrdiff_t)sizeof(T)) {
+    p = end;
+    return;
+  }
+  memcpy(p, &value, sizeof(T));
+  p += sizeof(T);
+}
+
+// Integers as 4 bytes (8 for 64-bit), floating point as float, strings as
+// length + bytes; the decoder knows which from the format specifier
+template <typename T>
+inline void log_pack(uint8_t *&p, uint8_t *end, T value) {
+  if constexpr (std::is_same<T, const char *>::value || std::is_same<T, char *>::value) {
+    if (end - p < 1) return;
+    size_t len = value ? strlen(value) : 0;
+    size_t room = end - p - 1;
+    if (len > room) len = room;
+    *p++ = len;
+    memcpy(p, value, len);
+    p += len;
+  } else if constexpr (std::is_floating_point<T>::value) {
+    log_pack_bytes(p, end, (float)value);
+  } else if constexpr (std::is_integral<T>::value && sizeof(T) == 8) {
+    log_pack_bytes(p, end, value);
+  } else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+    log_pack_bytes(p, end, (uint32_t)value);
+  } else if constexpr (std::is_pointer<T>::value) {
+    log_pack_bytes(p, end, (uint32_t)(uintptr_t)value);
+  } else {
+    static_assert(std::is_pointer<T>::value, "binary logs take numbers and C strings (use .c_str())");
+  }
+}
+
+template <typename... Args>
+void log_binary(uint8_t level, uint32_t token, Args... args) {
+  LogSlot *slot;
+  uint32_t pos;
+  if (!log_reserve(slot, pos)) return;
+
+  uint8_t *frame = slot->data;
+  uint32_t now = millis();
+  frame[0] = LOG_FRAME_SYNC;
+  frame[2] = level;
+  memcpy(frame + 3, &token, 4);
+  memcpy(frame + 7, &now, 4);
+
+  uint8_t *p = frame + LOG_FRAME_HEADER;
+  (log_pack(p, frame + LOG_SLOT_SIZE, args), ...);
+
+  frame[1] = p - frame - 2;
+  slot->len = p - frame;
+  log_commit(slot, pos);
+}
+
+#if LOG_BINARY
+#define LOG_AT(level, fmt, ...) \
+  log_binary(level, std::integral_constant<uint32_t, log_token(fmt)>::value, ##__VA_ARGS__)
+#else
+#define LOG_AT(level, fmt, ...) log_text(level, fmt, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_E(fmt, ...) LOG_AT(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_E(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_W(fmt, ...) LOG_AT(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOG_W(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_I(fmt, ...) LOG_AT(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define LOG_I(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_D(fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_D(fmt, ...) do {} while (0)
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Adafruit_SSD1306.h>
+
+// SSD1306 driver that counts frame flushes, so the render benchmark can tell
+// what each screen costs on the I2C bus. With headless set, frames stay in the
+// RAM buffer and nothing is sent to the panel. Geometry comes from the board
+// profile, so the framebuffer sizes and the pixel addressing below are
+// compile-time constants.
+template <class Profile>
+class MedboxDisplay : public Adafruit_SSD1306 {
+ public:
+  MedboxDisplay(TwoWire *twi, int8_t reset_pin)
+      : Adafruit_SSD1306(Profile::screen_width, Profile::screen_height, twi, reset_pin) {}
+
+  // Hides the (non-virtual) base version; every call site goes through the
+  // global MedboxDisplay object
+  void display() {
+    flushes++;
+    if (!headless) {
+      Adafruit_SSD1306::display();
+    }
+  }
+
+  // The library's drawPixel() for rotation 0 with the geometry fixed: the
+  // bounds checks compare against constants and the page row is a shift.
+  // Text and bitmaps are drawn one pixel at a time through here.
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (getRotation() != 0) {
+      Adafruit_SSD1306::drawPixel(x, y, color);
+      return;
+    }
+    if ((uint16_t)x >= Profile::screen_width || (uint16_t)y >= Profile::screen_height) return;
+
+    uint8_t &cell = buffer[x + (y / 8) * Profile::screen_width];
+    uint8_t bit = 1 << (y & 7);
+    switch (color) {
+      case SSD1306_WHITE:   cell |= bit; break;
+      case SSD1306_BLACK:   cell &= ~bit; break;
+      case SSD1306_INVERSE: cell ^= bit; break;
+    }
+  }
+
+  static constexpr uint32_t frame_bytes = Profile::frame_bytes;
+
+  // Bytes on the wire for one flush: the framebuffer, plus the address and
+  // command bytes and one control byte per I2C transaction (the library sends
+  // at most 127 data bytes per transaction on ESP32)
+  static constexpr uint32_t i2c_bytes_per_flush = frame_bytes + (frame_bytes + 126) / 127 * 2 + 10;
+
+  uint32_t flushes = 0;
+  bool headless = false;
+};
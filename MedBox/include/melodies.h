@@ -0,0 +1,214 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Compile-time RTTTL ringtones.
+//
+// RTTTL strings ("name:d=4,o=5,b=120:c,d,e,8p,...") are parsed by constexpr
+// functions into (frequency, duration) tables, so every tune ends up as a
+// const table in flash with no parsing or RAM cost at runtime. A malformed
+// string fails the build through the static_assert in RTTTL_TUNE.
+
+namespace rtttl {
+
+struct Note {
+  uint16_t freq;  // Hz, 0 = rest
+  uint16_t ms;
+};
+
+struct Tune {
+  const char *name;
+  const Note *notes;
+  uint8_t n_notes;
+};
+
+// Octave 8 (c8 .. b8); lower octaves are shifted down with rounding
+constexpr uint16_t OCTAVE_8[12] = {4186, 4435, 4699, 4978, 5274, 5588,
+                                   5920, 6272, 6645, 7040, 7459, 7902};
+
+struct Defaults {
+  unsigned duration;
+  unsigned octave;
+  unsigned bpm;
+  size_t body;  // index of the first note
+};
+
+constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+constexpr char lower(char c) { return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c; }
+
+constexpr bool is_space(char c) { return c == ' ' || c == '\t' || c == '\n'; }
+
+constexpr unsigned parse_uint(const char *s, size_t &i) {
+  unsigned v = 0;
+  while (is_digit(s[i])) {
+    v = v * 10 + (s[i] - '0');
+    i++;
+  }
+  return v;
+}
+
+// Semitone index within the octave, -1 for a rest, -2 for an invalid letter
+constexpr int semitone(char c) {
+  switch (lower(c)) {
+    case 'c': return 0;
+    case 'd': return 2;
+    case 'e': return 4;
+    case 'f': return 5;
+    case 'g': return 7;
+    case 'a': return 9;
+    case 'b': return 11;
+    case 'p': return -1;
+    default:  return -2;
+  }
+}
+
+// Standard RTTTL defaults when the control section omits a value
+constexpr Defaults parse_header(const char *s) {
+  Defaults def = {4, 6, 63, 0};
+  size_t i = 0;
+
+  while (s[i] && s[i] != ':') i++;  // skip the name
+  if (s[i]) i++;
+
+  while (s[i] && s[i] != ':') {
+    while (is_space(s[i]) || s[i] == ',') i++;
+    char key = lower(s[i]);
+    if (!s[i] || key == ':') break;
+    i++;
+    if (s[i] == '=') i++;
+    unsigned value = parse_uint(s, i);
+    if (key == 'd') def.duration = value;
+    else if (key == 'o') def.octave = value;
+    else if (key == 'b') def.bpm = value;
+  }
+  if (s[i]) i++;
+
+  def.body = i;
+  return def;
+}
+
+constexpr size_t count_notes(const char *s) {
+  size_t n = 0;
+  bool in_note = false;
+  for (size_t i = parse_header(s).body; s[i]; i++) {
+    if (s[i] == ',') {
+      in_note = false;
+    } else if (!is_space(s[i]) && !in_note) {
+      in_note = true;
+      n++;
+    }
+  }
+  return n;
+}
+
+// Parses one note starting at s[i] and leaves i on the following separator.
+// Grammar: [duration] letter [#] [.] [octave] [.]
+constexpr Note parse_note(const char *s, size_t &i, const Defaults &def, bool &ok) {
+  while (is_space(s[i]) || s[i] == ',') i++;
+
+  unsigned duration = is_digit(s[i]) ? parse_uint(s, i) : def.duration;
+  int step = semitone(s[i]);
+  if (step == -2 || duration == 0) ok = false;
+  i++;
+
+  if (s[i] == '#') {
+    step++;
+    i++;
+  }
+
+  bool dotted = false;
+  if (s[i] == '.') {
+    dotted = true;
+    i++;
+  }
+
+  unsigned octave = is_digit(s[i]) ? parse_uint(s, i) : def.octave;
+  if (s[i] == '.') {
+    dotted = true;
+    i++;
+  }
+
+  while (is_space(s[i])) i++;
+  if (s[i] && s[i] != ',') ok = false;
+
+  if (step == 12) {  // b# wraps into the next octave
+    step = 0;
+    octave++;
+  }
+  if (octave < 1 || octave > 8) ok = false;
+
+  uint32_t ms = duration ? 60000UL * 4 / def.bpm / duration : 0;
+  if (dotted) ms += ms / 2;
+
+  uint16_t freq = 0;
+  if (step >= 0 && ok) {
+    unsigned shift = 8 - octave;
+    freq = shift ? (OCTAVE_8[step] + (1u << (shift - 1))) >> shift : OCTAVE_8[step];
+  }
+
+  Note note = {freq, (uint16_t)ms};
+  return note;
+}
+
+constexpr bool is_valid(const char *s) {
+  Defaults def = parse_header(s);
+  if (def.bpm == 0 || def.duration == 0) return false;
+
+  size_t n = count_notes(s);
+  if (n == 0 || n > 255) return false;
+
+  bool ok = true;
+  size_t i = def.body;
+  for (size_t k = 0; k < n && ok; k++) {
+    parse_note(s, i, def, ok);
+  }
+  return ok;
+}
+
+template <size_t N>
+struct Melody {
+  Note notes[N];
+};
+
+template <size_t N>
+constexpr Melody<N> parse(const char *s) {
+  Melody<N> melody = {};
+  Defaults def = parse_header(s);
+  bool ok = true;
+  size_t i = def.body;
+  for (size_t k = 0; k < N; k++) {
+    melody.notes[k] = parse_note(s, i, def, ok);
+  }
+  return melody;
+}
+
+}  // namespace rtttl
+
+// Declares <id>_melody, a flash-resident note table built from an RTTTL string
+#define RTTTL_TUNE(id, text)                                                   \
+  constexpr char id##_rtttl[] = text;                                          \
+  static_assert(rtttl::is_valid(id##_rtttl), "malformed RTTTL tune: " #id);    \
+  constexpr auto id##_melody = rtttl::parse<rtttl::count_notes(id##_rtttl)>(id##_rtttl)
+
+#define TUNE_ENTRY(name, id) \
+  { name, id##_melody.notes, sizeof(id##_melody.notes) / sizeof(rtttl::Note) }
+
+// Alarm tunes. Keep them distinct in rhythm as well as pitch so doses can be
+// told apart without looking at the screen.
+RTTTL_TUNE(scale, "scale:d=4,o=4,b=120:c,d,e,f,g,a,b,c5");
+RTTTL_TUNE(chime, "chime:d=8,o=6,b=140:e,g#,b,e7,4p,e,g#,b,e7,4p");
+RTTTL_TUNE(triple, "triple:d=16,o=7,b=125:c,p,c,p,c,4p,c,p,c,p,c,4p");
+RTTTL_TUNE(descend, "descend:d=8,o=5,b=160:c6,b,a,g,f,e,d,c,4p");
+RTTTL_TUNE(elise, "elise:d=8,o=5,b=125:e6,d#6,e6,d#6,e6,b,d6,c6,4a,p,c,e,a,4b,p,e,g#,b,4c6");
+
+constexpr rtttl::Tune tunes[] = {
+  TUNE_ENTRY("Scale", scale),
+  TUNE_ENTRY("Chime", chime),
+  TUNE_ENTRY("Triple beep", triple),
+  TUNE_ENTRY("Descend", descend),
+  TUNE_ENTRY("Fur Elise", elise),
+};
+
+constexpr int n_tunes = sizeof(tunes) / sizeof(tunes[0]);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Over-the-air updates from a plain HTTP server.
+//
+// The device asks for OTA_SERVER/medbox-<key>.mbdp, a binary delta from the
+// running image to the new one built by tools/make_delta.py. The key is the
+// start of the running image's ELF SHA-256 (ota_image_key()), which the script
+// reads out of old.bin, so an updated device never asks for the patch that
+// produced it and reports "Up to date" until a newer one is served. The patch is
+// streamed straight into the inactive OTA partition: COPY ops read from the
+// running partition, so the whole image never has to fit in RAM, and deflated
+// patches are inflated on the fly (about 43 KB of heap while applying). A new
+// image stays in pending-verify state until ota_mark_healthy(); if it resets
+// before that, the bootloader rolls back to the previous one.
+//
+// Local test:
+//   python3 tools/make_delta.py old.bin new.bin out
+//   python3 -m http.server 8000 --directory out
+
+#ifndef OTA_SERVER
+#define OTA_SERVER "http://192.168.1.100:8000"
+#endif
+
+#define OTA_HEALTHY_AFTER_MS (60UL * 1000)  // running this long, with Wi-Fi up and NTP synced, counts as a good boot
+
+enum OtaResult {
+  OTA_NO_UPDATE,
+  OTA_APPLIED,   // reboot to run the new image
+  OTA_FAILED     // see ota_last_error()
+};
+
+typedef void (*OtaProgressCallback)(size_t written, size_t total);
+
+OtaResult ota_check_and_apply(OtaProgressCallback progress);
+const char *ota_last_error();
+const char *ota_image_key();  // 16 hex digits naming the running image
+void ota_mark_healthy();
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Alarm recurrence rules compiled into bitmap schedule tables.
+//
+// Each rule gets one bit. Compiling builds a per-weekday mask of the rules
+// allowed on that weekday, a mask of the rules whose date range covers the
+// day, and a 1440-entry minute table where entry m holds the bits of every
+// rule firing at minute m of that day. "Does anything fire this minute?" is
+// then one lookup and one AND, however many rules there are. The table is
+// rebuilt when the day changes or a rule is edited.
+
+#define MAX_RULES       8      // one bit per rule in a uint8_t
+#define MINUTES_PER_DAY 1440
+
+// start_day of a rule edited before the clock was set; the rule stays
+// inactive until the caller fills in the real day
+#define START_DAY_PENDING INT32_MIN
+
+enum RecurrenceKind {
+  RULE_ONCE = 0,           // next hh:mm only (the alarm stays triggered afterwards)
+  RULE_DAILY = 1,
+  RULE_WEEKDAYS = 2,       // hh:mm on the days in weekdays
+  RULE_EVERY_N_HOURS = 3   // hh:mm on start_day, then every every_hours hours
+};
+
+struct RecurrenceRule {
+  uint8_t kind;
+  uint8_t hour;
+  uint8_t minute;
+  uint8_t weekdays;      // bit 0 = Sunday .. bit 6 = Saturday
+  uint8_t every_hours;   // 1..23
+  uint8_t reserved;
+  uint16_t n_days;       // active for this many days from start_day, 0 = no end
+  int32_t start_day;     // first active day, in days since 1970-01-01 (local)
+};
+
+struct ScheduleTable {
+  int32_t day;                             // day the table was compiled for
+  uint8_t weekday_mask[7];                 // rules allowed on each weekday
+  uint8_t day_mask;                        // rules active on this day
+  uint8_t minute_rules[MINUTES_PER_DAY];   // rules firing at each minute
+};
+
+RecurrenceRule recurrence_default(int hour, int minute, bool repeat, int32_t today);
+void schedule_compile(ScheduleTable &table, const RecurrenceRule *rules, int n_rules, int32_t day);
+String recurrence_describe(const RecurrenceRule &rule);
+
+int32_t days_from_civil(int year, int month, int day);
+inline int weekday_of(int32_t day) { return (int)(((day % 7) + 11) % 7); }  // 1970-01-01 was a Thursday
+
+// Bits of the rules that fire at minute_of_day on the compiled day
+inline uint8_t schedule_due(const ScheduleTable &table, int minute_of_day) {
+  return table.minute_rules[minute_of_day] & table.day_mask;
+}
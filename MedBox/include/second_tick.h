@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Arduino.h>
+
+// One tick per wall-clock second, aligned to the second boundary of system
+// time rather than to millis(). A one-shot esp_timer is armed for the next
+// boundary each time it fires, so slews are followed automatically; call
+// second_tick_rearm() after the clock is stepped (e.g. on an NTP sync).
+//
+// While the clock is slewed backwards the timer can fire a little before the
+// boundary; it is then re-armed for the remainder and no tick is produced, so
+// each tick carries the second it belongs to and loop() renders exactly that.
+
+struct TickStats {
+  uint32_t ticks;
+  uint32_t missed;         // seconds that passed while loop() was busy
+  uint32_t early;          // timer fired before the boundary and was re-armed
+  int32_t last_phase_us;   // how far after the boundary the last tick fired
+  int32_t max_phase_us;
+  int32_t mean_phase_us;   // running mean of the timer phase
+  int32_t last_render_us;  // how far after the boundary loop() took the tick
+  int32_t mean_render_us;
+};
+
+void second_tick_begin();
+void second_tick_rearm();
+bool second_tick_take(time_t &second);   // true once for each new second
+TickStats second_tick_stats();
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Time discipline on top of SNTP.
+//
+// Every NTP sample is compared against the local oscillator (esp_timer) to
+// estimate its frequency error in ppm. Between syncs the system clock is slewed
+// with adjtime() so it follows the drift-corrected model instead of the raw
+// crystal, and the SNTP poll interval is stretched as the drift estimate settles
+// so the radio has to wake less often.
+
+#define NTP_MIN_SYNC_INTERVAL_S  (15UL * 60)     // first polls, while drift is unknown
+#define NTP_MAX_SYNC_INTERVAL_S  (24UL * 3600)   // never go longer than a day
+#define NTP_ERROR_BUDGET_MS      500             // target bound between two syncs
+#define NTP_DRIFT_FLOOR_PPM      2.0f            // residual after compensation (temperature swing)
+
+struct TimeSyncStats {
+  uint32_t sync_count;
+  float drift_ppm;          // measured oscillator error, + means the local clock runs slow
+  float drift_spread_ppm;   // mean deviation of drift samples, i.e. confidence
+  int32_t last_offset_ms;   // error of the disciplined clock seen at the last sync
+  uint32_t sync_interval_s; // current SNTP poll interval
+  uint32_t since_sync_s;    // seconds since the last successful sync
+  uint32_t error_bound_ms;  // worst-case error right now
+};
+
+void time_discipline_begin();
+bool time_discipline_update();   // call from loop(); true when a new NTP sample was applied
+bool time_discipline_synced();
+TimeSyncStats time_discipline_stats();
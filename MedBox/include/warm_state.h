@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "recurrence.h"
+
+// Runtime state carried across warm resets.
+//
+// The snapshot lives in RTC slow memory, which keeps its contents through
+// software, panic, watchdog and brown-out resets but not through power loss.
+// Two copies are written alternately and each is CRC-checked, so a reset in
+// the middle of a save still leaves the previous snapshot intact. After a
+// power-on (or any reset that clears RTC memory) warm_state_load() fails and
+// the caller falls back to the settings in NVS.
+//
+// Bump WARM_STATE_VERSION whenever WarmState changes layout, so an image
+// flashed over OTA does not pick up a snapshot written by the previous one.
+
+#define WARM_STATE_VERSION 1
+
+struct WarmState {
+  int64_t epoch_us;                  // wall clock when the snapshot was taken
+  float temperature;                 // last DHT reading (NAN = none yet)
+  float humidity;
+  uint32_t snooze_left_ms;
+  int8_t snooze_alarm;               // -1 = no snooze running
+  uint8_t n_alarms;
+  uint8_t triggered;                 // one bit per alarm
+  bool alarm_enabled;
+
+  // Settings, so a warm boot does not have to read NVS
+  float utc_offset;
+  uint8_t alarm_hours[MAX_RULES];
+  uint8_t alarm_minutes[MAX_RULES];
+  uint8_t alarm_repeat;              // one bit per alarm
+  uint8_t alarm_tune[MAX_RULES];
+  RecurrenceRule alarm_rules[MAX_RULES];
+};
+
+bool warm_state_load(WarmState &state);   // true after a warm reset with an intact snapshot
+void warm_state_save(const WarmState &state);
+const char *warm_state_reset_reason();
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Async HTTP dashboard on port 80.
+//
+// GET /              gzipped static page from flash (web/dashboard.html)
+// GET /history.json  temperature/humidity history as [[temp, hum], ...]
+// WS  /ws            JSON objects holding only the fields that changed
+//
+// Requests are served from the AsyncTCP task, so nothing here ever waits in
+// loop(). loop() only hands over a snapshot; it is diffed against the last
+// one sent and pushed to clients when something changed.
+
+#define WEB_MAX_CLIENTS       3                 // further WebSocket clients are refused
+#define WEB_MAX_ALARMS        8
+#define WEB_HISTORY_LEN       288               // 24 h ...
+#define WEB_HISTORY_PERIOD_MS (5UL * 60 * 1000) // ... at one sample per 5 minutes
+
+struct DashboardAlarm {
+  uint8_t hour;
+  uint8_t minute;
+  char repeat[16];       // recurrence_describe() text, e.g. "Daily", "-MTWTF- 10d"
+  bool triggered;
+};
+
+struct DashboardSnapshot {
+  char clock[9];         // HH:MM:SS
+  char date[6];          // DD/MM
+  float temperature;
+  float humidity;
+  bool alarms_enabled;
+  uint8_t n_alarms;
+  DashboardAlarm alarms[WEB_MAX_ALARMS];
+  uint16_t snooze_left_s;  // 0 = no snooze
+};
+
+void web_dashboard_begin();
+void web_dashboard_publish(const DashboardSnapshot &snapshot);
@@ -0,0 +1,120 @@
+#include "log.h"
+
+#include <stdarg.h>
+
+static_assert((LOG_SLOTS & (LOG_SLOTS - 1)) == 0, "LOG_SLOTS must be a power of two");
+
+const uint32_t DRAIN_IDLE_MS = 10;
+
+// Bounded MPMC queue (Vyukov): a slot is free for position p when its seq
+// equals p, and holds a message for the reader when seq equals p + 1
+static LogSlot slots[LOG_SLOTS];
+static std::atomic<uint32_t> enqueue_pos(0);
+static std::atomic<uint32_t> dequeue_pos(0);
+static std::atomic<uint32_t> dropped(0);
+
+static TaskHandle_t drain_task = NULL;
+
+bool log_reserve(LogSlot *&slot, uint32_t &pos) {
+  pos = enqueue_pos.load(std::memory_order_relaxed);
+  while (true) {
+    slot = &slots[pos & (LOG_SLOTS - 1)];
+    int32_t diff = (int32_t)(slot->seq.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        return true;
+      }
+    } else if (diff < 0) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      pos = enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void log_commit(LogSlot *slot, uint32_t pos) {
+  slot->seq.store(pos + 1, std::memory_order_release);
+}
+
+void log_text(uint8_t level, const char *fmt, ...) {
+  LogSlot *slot;
+  uint32_t pos;
+  if (!log_reserve(slot, pos)) return;
+
+  static const char LEVEL_LETTERS[] = "-EWID";
+  unsigned long now = millis();
+  char *text = (char *)slot->data;
+
+  int n = snprintf(text, LOG_SLOT_SIZE, "[%5lu.%03lu] %c ",
+                   now / 1000, now % 1000, LEVEL_LETTERS[level <= LOG_LEVEL_DEBUG ? level : 0]);
+
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(text + n, LOG_SLOT_SIZE - n - 1, fmt, args);
+  va_end(args);
+
+  // Truncated lines still end with a newline
+  size_t len = strlen(text);
+  text[len++] = '\n';
+  slot->len = len;
+
+  log_commit(slot, pos);
+}
+
+// Only the drain task (or log_flush() before it starts) reads the queue
+static bool drain_one() {
+  uint32_t pos = dequeue_pos.load(std::memory_order_relaxed);
+  LogSlot *slot = &slots[pos & (LOG_SLOTS - 1)];
+  if (slot->seq.load(std::memory_order_acquire) != pos + 1) return false;
+
+  Serial.write(slot->data, slot->len);
+
+  slot->seq.store(pos + LOG_SLOTS, std::memory_order_release);
+  dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+  return true;
+}
+
+static void report_dropped() {
+  uint32_t count = dropped.exchange(0, std::memory_order_relaxed);
+  if (count == 0) return;
+#if LOG_BINARY
+  log_binary(LOG_LEVEL_WARN, LOG_TOKEN_DROPPED, count);
+#else
+  log_text(LOG_LEVEL_WARN, "%u log messages dropped", (unsigned)count);
+#endif
+}
+
+static void drain_loop(void *arg) {
+  while (true) {
+    report_dropped();
+    if (!drain_one()) {
+      vTaskDelay(pdMS_TO_TICKS(DRAIN_IDLE_MS));
+    }
+  }
+}
+
+void log_begin() {
+  enqueue_pos.store(0);
+  dequeue_pos.store(0);
+  for (uint32_t i = 0; i < LOG_SLOTS; i++) {
+    slots[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  Serial.setTxBufferSize(1024);
+  Serial.begin(LOG_BAUD);
+
+  xTaskCreatePinnedToCore(drain_loop, "log_drain", 3072, NULL, 1, &drain_task, 0);
+}
+
+void log_flush() {
+  if (drain_task == NULL) {
+    report_dropped();
+    while (drain_one()) {}
+  } else {
+    while (dequeue_pos.load() != enqueue_pos.load()) {
+      vTaskDelay(1);
+    }
+  }
+  Serial.flush();
+}
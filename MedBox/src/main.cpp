@@ -4,24 +4,38 @@
 #include <DHTesp.h>
 #include <WiFi.h>
 #include <Preferences.h>
+#include <sys/time.h>
+
+#include "board_profile.h"
+#include "log.h"
+#include "medbox_display.h"
+#include "melodies.h"
+#include "ota_update.h"
+#include "recurrence.h"
+#include "second_tick.h"
+#include "time_discipline.h"
+#include "warm_state.h"
+#include "web_dashboard.h"
 
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 64
 #define OLED_RESET -1
 #define SCREEN_ADDRESS 0x3C
 
-#define BUZZER 5
-#define LED_1 15
-#define PB_CANCEL 34
-#define PB_OK 32
-#define PB_UP 33
-#define PB_DOWN 35
-#define DHTPIN 12
+// Pin map and geometry of the selected board profile (board_profile.h)
+constexpr int SCREEN_WIDTH = Board::screen_width;
+constexpr int SCREEN_HEIGHT = Board::screen_height;
+
+constexpr uint8_t BUZZER = Board::buzzer;
+constexpr uint8_t LED_1 = Board::led;
+constexpr uint8_t PB_CANCEL = Board::pb_cancel;
+constexpr uint8_t PB_OK = Board::pb_ok;
+constexpr uint8_t PB_UP = Board::pb_up;
+constexpr uint8_t PB_DOWN = Board::pb_down;
+constexpr uint8_t DHTPIN = Board::dht_pin;
 
 #define NTP_SERVER     "pool.ntp.org"
 #define UTC_OFFSET_DST 0
 
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire , OLED_RESET);
+MedboxDisplay<Board> display(&Wire, OLED_RESET);
 DHTesp dhtSensor;
 
 Preferences prefs;
@@ -32,17 +46,28 @@ int hours = 0;
 int minutes = 0;
 int seconds = 0;
 int month = 0;
+int32_t current_day = 0;  // local days since 1970-01-01
+bool time_valid = false;  // the fields above hold a real time, not the boot zeros
 float UTC_OFFSET = 0.0; 
 
+// Last DHT reading, refreshed by check_temp()
+float last_temperature = NAN;
+float last_humidity = NAN;
+
 unsigned long timeNow = 0;
-unsigned long timeLast = 0;
 
 bool alarm_enabled = true;
-int n_alarms = 2;
-int alarm_hours[] = {0,1};
-int alarm_minutes[] = {1,10};
-bool alarm_triggered[] = {false, false};
-bool alarm_repeat[] = {true, true};  // true = repeat daily, false = one-time
+constexpr int n_alarms = Board::n_alarms;
+int alarm_hours[n_alarms] = {};
+int alarm_minutes[n_alarms] = {};
+bool alarm_triggered[n_alarms] = {};
+bool alarm_repeat[n_alarms] = {};         // true = repeat, false = one-time
+int alarm_tune[n_alarms] = {};            // index into tunes[] (melodies.h)
+RecurrenceRule alarm_rules[n_alarms];     // recurrence of each alarm (recurrence.h)
+
+// Today's compiled schedule; rebuilt on day change or when a rule is edited
+ScheduleTable schedule;
+bool schedule_dirty = true;
 
 
 // Snooze functionality
@@ -51,26 +76,17 @@ unsigned long snooze_start_time = 0;
 int snooze_alarm_id = -1;
 const unsigned long SNOOZE_DURATION = 5 * 60 * 1000; // 5 minutes in milliseconds
 
-int n_notes = 8;
-int C = 262;
-int D = 294;
-int E = 330;
-int F = 349;
-int G = 392;
-int A = 440;
-int B = 494;
-int C_H = 523;
-int notes[] = {C, D, E, F, G, A, B, C_H};
-
 int current_mode = 0;
-int max_modes = 7;
-String modes[] = { "1 - Set Time",
-                   "2 - Set Alarm 1", 
-                   "3 - Set Alarm 2", 
-                   "4 - Disable Alarms", 
-                   "5 - Set Timezone", 
-                   "6 - View Alarms", 
-                   "7 - Delete Alarm"};
+// "Set Alarm N" for each alarm the board has, then the fixed entries
+const char *menu_items[] = { "Disable Alarms",
+                             "Set Timezone",
+                             "View Alarms",
+                             "Delete Alarm",
+                             "Diagnostics",
+                             "Update Firmware"};
+constexpr int n_menu_items = sizeof(menu_items) / sizeof(menu_items[0]);
+constexpr int max_modes = 1 + n_alarms + n_menu_items;
+String modes[max_modes];
 
 // Icon bitmaps (8x8)
 const unsigned char alarm_on_icon [] PROGMEM = {
@@ -125,11 +141,26 @@ void go_to_menu();
 void check_temp();
 void run_mode(int mode);
 void set_timezone();
-void update_time();
+void update_time(time_t now = time(NULL));
+void check_alarms();
 void delete_alarm();
 void view_alarms();
-void ring_alarm();
+void ring_alarm(int alarm);
+void load_settings();
 void save_settings();
+void save_warm_state();
+void restore_warm_state(const WarmState &state);
+void view_diagnostics();
+void publish_dashboard();
+void update_firmware();
+void draw_menu(int mode);
+void draw_ring_alarm();
+void draw_alarm_details(int alarm);
+void draw_delete_alarm(int alarm);
+#ifdef RENDER_BENCH
+void run_render_bench();
+#endif
+void build_modes();
 void draw_icon(const unsigned char *icon, int x, int y) {
   display.drawBitmap(x, y, icon, 8, 8, WHITE);
 }
@@ -144,47 +175,64 @@ void setup() {
   pinMode(PB_UP, INPUT);
   pinMode(PB_DOWN, INPUT);
 
-  dhtSensor.setup(DHTPIN, DHTesp::DHT22);
-  Serial.begin(9600);
+  log_begin();
+  dhtSensor.setup(DHTPIN, Board::sensor);
+  build_modes();
 
   if (!display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS)) {
-    Serial.println(F("SSD1306 allocation failed"));
+    LOG_E("SSD1306 allocation failed");
+    log_flush();
     for (;;);
   }
 
-  display.display();
-  delay(500);
+#ifdef RENDER_BENCH
+  run_render_bench();
+  for (;;) delay(1000);
+#endif
 
-  // Connect to Wi-Fi
-  WiFi.begin("Wokwi-GUEST", "", 6);
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(250);
-    display.clearDisplay();
-    print_line("Connecting to WIFI", 0, 0, 2);
+  // After a watchdog, panic or brown-out reset, carry on from the RTC snapshot
+  // instead of replaying the boot sequence (warm_state.h)
+  WarmState warm;
+  bool warm_boot = warm_state_load(warm) && warm.n_alarms == n_alarms;
+
+  if (warm_boot) {
+    restore_warm_state(warm);
+
+    // Connects in the background; the dashboard comes up with it
+    WiFi.begin("Wokwi-GUEST", "", 6);
+    web_dashboard_begin();
   }
+  else {
+    display.display();
+    delay(500);
 
-  display.clearDisplay();
-  print_line("Connected to WIFI", 0, 0, 2);
+    // Connect to Wi-Fi
+    WiFi.begin("Wokwi-GUEST", "", 6);
+    while (WiFi.status() != WL_CONNECTED) {
+      delay(250);
+      display.clearDisplay();
+      print_line("Connecting to WIFI", 0, 0, 2);
+    }
 
-  // Load saved settings from EEPROM
-  prefs.begin("medibox", true); // true = read-only
-  UTC_OFFSET = prefs.getFloat("tz_offset", 0.0);  // default 0.0
-  alarm_enabled = prefs.getBool("alarm_en", true);
-  for (int i = 0; i < n_alarms; i++) {
-    alarm_hours[i] = prefs.getInt(("a_hr" + String(i)).c_str(), 0);
-    alarm_minutes[i] = prefs.getInt(("a_min" + String(i)).c_str(), 0);
-    alarm_triggered[i] = false; // always reset on boot
-    alarm_repeat[i] = prefs.getBool(("a_rep" + String(i)).c_str(), true);
+    display.clearDisplay();
+    print_line("Connected to WIFI", 0, 0, 2);
+    print_line(WiFi.localIP().toString(), 0, 40, 1);
+    LOG_I("Wi-Fi connected, dashboard at http://%s/", WiFi.localIP().toString().c_str());
+    web_dashboard_begin();
 
+    load_settings();
   }
-  prefs.end();
 
   // Configure time with loaded timezone
+  time_discipline_begin();
   configTime((int)(UTC_OFFSET * 3600), UTC_OFFSET_DST, NTP_SERVER);
+  second_tick_begin();
 
-  display.clearDisplay();
-  print_line("Welcome to Medibox!", 10, 20, 2);
-  delay(500);
+  if (!warm_boot) {
+    display.clearDisplay();
+    print_line("Welcome to Medibox!", 10, 20, 2);
+    delay(500);
+  }
   display.clearDisplay();
 }
 
@@ -192,21 +240,42 @@ void setup() {
 void loop() {
   unsigned long currentMillis = millis();
 
-  if (currentMillis - timeLast >= 1000) {
-    timeLast = currentMillis;
-    update_time();
+  // A sync may have stepped the clock; realign the tick to the new second
+  if (time_discipline_update()) {
+    second_tick_rearm();
+  }
+
+  // Confirm a freshly flashed OTA image once it has run for a while and shown
+  // it can still reach the network, so it can be updated again later
+  static bool ota_confirmed = false;
+  if (!ota_confirmed && currentMillis >= OTA_HEALTHY_AFTER_MS &&
+      WiFi.status() == WL_CONNECTED && time_discipline_synced()) {
+    ota_confirmed = true;
+    ota_mark_healthy();
+  }
+
+  // Once per wall-clock second: redraw and evaluate alarms for that second
+  time_t tick_second;
+  if (second_tick_take(tick_second)) {
+    update_time(tick_second);
     draw_main_display();
+    publish_dashboard();
+
+    check_alarms();
+    save_warm_state();
   }
 
   // Check if snooze timer has elapsed
   if (snooze_active && (currentMillis - snooze_start_time >= SNOOZE_DURATION)) {
     snooze_active = false;
-    ring_alarm(); // Ring alarm again after snooze
+    ring_alarm(snooze_alarm_id); // Ring alarm again after snooze
+    save_warm_state();
   }
 
-  if (digitalRead(PB_OK) == LOW) {
+  if (button_down<PB_OK>()) {
     delay(200);
     go_to_menu();
+    save_warm_state();
   }
 
   // Only check temperature every 2 seconds
@@ -215,16 +284,6 @@ void loop() {
     lastTempCheck = currentMillis;
     check_temp();
   }
-  
-  // Check for alarms
-  if (alarm_enabled) {
-    for (int i=0; i<n_alarms; i++){
-      if (!alarm_triggered[i] && alarm_hours[i] == hours && alarm_minutes[i] == minutes && seconds < 10){
-        ring_alarm();
-        alarm_triggered[i] = true;
-      }
-    }
-  }
 }
 
 
@@ -262,19 +321,19 @@ void draw_main_display() {
   display.setCursor(80, 30);
   display.print("TZ: " + String(UTC_OFFSET, 1));
 
-  // Temp and humidity
-  TempAndHumidity data = dhtSensor.getTempAndHumidity();
-  
+  // Temp and humidity, from the reading check_temp() keeps
   // Temp icon + value
   draw_icon(thermometer_icon, 0, 40);
   display.setCursor(10, 40);
-  display.print(data.temperature, 1);
+  if (isnan(last_temperature)) display.print("--");
+  else display.print(last_temperature, 1);
   display.print("C");
 
   // Humidity icon + value
   draw_icon(droplet_icon, 60, 40);
   display.setCursor(70, 40);
-  display.print(data.humidity, 0);
+  if (isnan(last_humidity)) display.print("--");
+  else display.print(last_humidity, 0);
   display.print("%");
 
   // Snooze countdown
@@ -301,46 +360,66 @@ void draw_main_display() {
 
 
 
-void update_time() {
+void update_time(time_t now) {
+  // Logged once at boot and then on change only; this runs every tick while
+  // unsynced
+  static bool warned = false;
+
+  // Same validity rule as getLocalTime(): a clock still in 1970 is not set
   struct tm timeinfo;
-  if (getLocalTime(&timeinfo)) {
+  localtime_r(&now, &timeinfo);
+  if (timeinfo.tm_year > 2016 - 1900) {
+    if (!time_valid) LOG_I("Time available");
+    time_valid = true;
+
     hours = timeinfo.tm_hour;
     minutes = timeinfo.tm_min;
     seconds = timeinfo.tm_sec;
     days = timeinfo.tm_mday;
     month = timeinfo.tm_mon + 1; // tm_mon is 0-11, so we add 1
+    current_day = days_from_civil(timeinfo.tm_year + 1900, month, days);
   } else {
-    Serial.println("Failed to get time from NTP.");
+    if (time_valid || !warned) LOG_W("Failed to get time from NTP.");
+    warned = true;
+    time_valid = false;
   }
 }
 
-void ring_alarm() {
+void draw_ring_alarm() {
   display.clearDisplay();
   print_line("MEDICINE TIME!", 0, 0, 2);
   print_line("OK=Dismiss CANCEL=Snooze", 0, 40, 1);
+}
+
+void ring_alarm(int alarm) {
+  draw_ring_alarm();
 
   digitalWrite(LED_1, HIGH);
 
+  const rtttl::Tune &tune = tunes[alarm_tune[alarm]];
+
   unsigned long alarmStartTime = millis();
   bool alarmSnoozed = false;
 
   // Ring for at most 30 seconds if no button is pressed
   while (millis() - alarmStartTime < 30000) {
-    for (int i = 0; i < n_notes; i++) {
-      if (digitalRead(PB_CANCEL) == LOW) {
+    for (int i = 0; i < tune.n_notes; i++) {
+      if (button_down<PB_CANCEL>()) {
         delay(200);
         alarmSnoozed = true;
         break;
       }
-      else if (digitalRead(PB_OK) == LOW) {
+      else if (button_down<PB_OK>()) {
         delay(200);
         digitalWrite(LED_1, LOW);
         display.clearDisplay();
         return; // Dismiss alarm completely
       }
 
-      tone(BUZZER, notes[i]);
-      delay(500);
+      if (tune.notes[i].freq != 0) {
+        tone(BUZZER, tune.notes[i].freq);
+      }
+      delay(tune.notes[i].ms);
       noTone(BUZZER);
       delay(2);
     }
@@ -361,6 +440,7 @@ void ring_alarm() {
 
     snooze_active = true;
     snooze_start_time = millis();
+    snooze_alarm_id = alarm;
   }
 
   // Mark one-time alarms as triggered
@@ -379,35 +459,67 @@ void ring_alarm() {
 void update_time_with_check_alarm(void){
   update_time();
   draw_main_display();
+  check_alarms();
+}
 
-  if (alarm_enabled == true){
-    for (int i=0; i<n_alarms; i++){
-      if (alarm_triggered[i] == false && alarm_hours[i] == hours && alarm_minutes[i] == minutes){
-        ring_alarm();
-        alarm_triggered[i] = true;
-      }
+void refresh_schedule() {
+  if (!schedule_dirty && schedule.day == current_day) return;
+
+  bool started = false;
+  for (int i = 0; i < n_alarms; i++) {
+    alarm_rules[i].hour = alarm_hours[i];
+    alarm_rules[i].minute = alarm_minutes[i];
+
+    // Courses set up before the clock was known start on the first real day
+    if (alarm_rules[i].start_day == START_DAY_PENDING && current_day > 0) {
+      alarm_rules[i].start_day = current_day;
+      started = true;
+    }
+  }
+  if (started) save_settings();
+
+  schedule_compile(schedule, alarm_rules, n_alarms, current_day);
+  schedule_dirty = false;
+}
+
+void check_alarms() {
+  // Until the first SNTP reply the time reads 00:00 on day 0, which would
+  // match every unset slot
+  if (!alarm_enabled || !time_valid) return;
+
+  refresh_schedule();
+  uint8_t due = schedule_due(schedule, hours * 60 + minutes);
+
+  for (int i = 0; i < n_alarms; i++) {
+    bool fires = due & (1 << i);
+    if (fires && !alarm_triggered[i] && seconds < 10) {
+      ring_alarm(i);
+      alarm_triggered[i] = true;
+    }
+    else if (!fires && alarm_repeat[i]) {
+      alarm_triggered[i] = false;  // re-arm for the next occurrence
     }
   }
 }
 
 int wait_for_button_press(){
   while(true){
-    if (digitalRead(PB_UP) == LOW){
+    if (button_down<PB_UP>()){
       delay(200);
       return PB_UP;
     }
 
-    else if (digitalRead(PB_DOWN) == LOW){
+    else if (button_down<PB_DOWN>()){
       delay(200);
       return PB_DOWN;
     }
     
-    else if (digitalRead(PB_OK) == LOW){
+    else if (button_down<PB_OK>()){
       delay(200);
       return PB_OK;
     }
 
-    else if (digitalRead(PB_CANCEL) == LOW){
+    else if (button_down<PB_CANCEL>()){
       delay(200);
       return PB_CANCEL;
     }
@@ -416,10 +528,14 @@ int wait_for_button_press(){
   }
 }
 
+void draw_menu(int mode) {
+  display.clearDisplay();
+  print_line(modes[mode], 0, 0, 2);
+}
+
 void go_to_menu() {
-  while (digitalRead(PB_CANCEL) == HIGH){
-    display.clearDisplay();
-    print_line(modes[current_mode], 0, 0, 2);
+  while (!button_down<PB_CANCEL>()){
+    draw_menu(current_mode);
 
     int pressed = wait_for_button_press();
     if (pressed == PB_UP){
@@ -438,7 +554,7 @@ void go_to_menu() {
 
     else if (pressed == PB_OK){
       delay(200);
-      Serial.println(current_mode);
+      LOG_D("Menu mode %d", current_mode);
       run_mode(current_mode);
     }
 
@@ -521,6 +637,129 @@ void set_time() {
 }
 
 
+void set_recurrence(int alarm) {
+  const char *kind_names[] = {"Once", "Daily", "Weekdays", "Every N hrs"};
+  RecurrenceRule rule = alarm_rules[alarm];
+
+  // Ask how this alarm should repeat
+  while (true) {
+    display.clearDisplay();
+    print_line("Repeat:", 0, 0, 2);
+    print_line(kind_names[rule.kind], 0, 30, 2);
+
+    int pressed = wait_for_button_press();
+    if (pressed == PB_UP) {
+      rule.kind = (rule.kind + 1) % 4;
+    }
+
+    else if (pressed == PB_DOWN) {
+      rule.kind = (rule.kind + 3) % 4;
+    }
+
+    else if (pressed == PB_OK) {
+      break;
+    }
+
+    else if (pressed == PB_CANCEL) {
+      return;
+    }
+  }
+
+  if (rule.kind == RULE_WEEKDAYS) {
+    // UP/DOWN toggles the highlighted day, OK moves to the next one
+    const char *day_names[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    if (rule.weekdays == 0) rule.weekdays = 0x7F;
+    int day = 0;
+    while (day < 7) {
+      display.clearDisplay();
+      print_line(day_names[day], 0, 0, 2);
+      print_line((rule.weekdays & (1 << day)) ? "Yes" : "No", 0, 30, 2);
+      print_line(recurrence_describe(rule), 0, 55, 1);
+
+      int pressed = wait_for_button_press();
+      if (pressed == PB_UP || pressed == PB_DOWN) {
+        rule.weekdays ^= 1 << day;
+      }
+
+      else if (pressed == PB_OK) {
+        day++;
+      }
+
+      else if (pressed == PB_CANCEL) {
+        return;
+      }
+    }
+    if (rule.weekdays == 0) rule.kind = RULE_DAILY;  // no day left means every day
+  }
+
+  else if (rule.kind == RULE_EVERY_N_HOURS) {
+    if (rule.every_hours < 1 || rule.every_hours > 23) rule.every_hours = 8;
+    while (true) {
+      display.clearDisplay();
+      print_line("Every " + String(rule.every_hours) + "h", 0, 0, 2);
+      print_line("from the set time", 0, 30, 1);
+
+      int pressed = wait_for_button_press();
+      if (pressed == PB_UP) {
+        rule.every_hours = rule.every_hours % 23 + 1;
+      }
+
+      else if (pressed == PB_DOWN) {
+        rule.every_hours = rule.every_hours > 1 ? rule.every_hours - 1 : 23;
+      }
+
+      else if (pressed == PB_OK) {
+        break;
+      }
+
+      else if (pressed == PB_CANCEL) {
+        return;
+      }
+    }
+  }
+
+  if (rule.kind != RULE_ONCE) {
+    // Course length, counted from today; 0 keeps it going
+    int n_days = rule.n_days;
+    while (true) {
+      display.clearDisplay();
+      print_line("For days:", 0, 0, 2);
+      print_line(n_days == 0 ? "No end" : String(n_days), 0, 30, 2);
+
+      int pressed = wait_for_button_press();
+      if (pressed == PB_UP) {
+        n_days = (n_days + 1) % 366;
+      }
+
+      else if (pressed == PB_DOWN) {
+        n_days -= 1;
+        if (n_days < 0) n_days = 365;
+      }
+
+      else if (pressed == PB_OK) {
+        break;
+      }
+
+      else if (pressed == PB_CANCEL) {
+        return;
+      }
+    }
+    rule.n_days = n_days;
+  }
+
+  // An ongoing course keeps its start day (and every-N-hours phase); only a
+  // new kind or course length starts it over, from today. current_day is 0
+  // until the clock is set, so then the start waits for refresh_schedule()
+  const RecurrenceRule &old = alarm_rules[alarm];
+  if (rule.kind != old.kind || rule.n_days != old.n_days) {
+    rule.start_day = current_day > 0 ? current_day : START_DAY_PENDING;
+  }
+  alarm_rules[alarm] = rule;
+  alarm_repeat[alarm] = rule.kind != RULE_ONCE;
+  alarm_triggered[alarm] = false;
+  schedule_dirty = true;
+}
+
 void set_alarm(int alarm) {
   int temp_hour = alarm_hours[alarm];
   while (true) {
@@ -542,6 +781,7 @@ void set_alarm(int alarm) {
     else if (pressed == PB_OK) {
       delay(200);
       alarm_hours[alarm] = temp_hour;
+      schedule_dirty = true;
       break;
     }
 
@@ -571,6 +811,7 @@ void set_alarm(int alarm) {
     else if (pressed == PB_OK) {
       delay(200);
       alarm_minutes[alarm] = temp_minute;
+      schedule_dirty = true;
       break;
     }
 
@@ -580,20 +821,27 @@ void set_alarm(int alarm) {
     }
   }
 
-  // Ask if this alarm should repeat
-  bool repeat = alarm_repeat[alarm];
+  set_recurrence(alarm);
+
+  // Pick the tune, so different doses sound different
+  int tune = alarm_tune[alarm];
   while (true) {
     display.clearDisplay();
-    print_line("Repeat daily?", 0, 0, 2);
-    print_line(repeat ? "Yes" : "No", 0, 30, 2);
+    print_line("Tune:", 0, 0, 2);
+    print_line(tunes[tune].name, 0, 30, 1);
 
     int pressed = wait_for_button_press();
-    if (pressed == PB_UP || pressed == PB_DOWN) {
-      repeat = !repeat;
+    if (pressed == PB_UP) {
+      tune = (tune + 1) % n_tunes;
+    }
+
+    else if (pressed == PB_DOWN) {
+      tune -= 1;
+      if (tune < 0) tune = n_tunes - 1;
     }
 
     else if (pressed == PB_OK) {
-      alarm_repeat[alarm] = repeat;
+      alarm_tune[alarm] = tune;
       break;
     }
 
@@ -611,14 +859,33 @@ void set_alarm(int alarm) {
 }
 
 
+void build_modes() {
+  int n = 0;
+  modes[n] = String(n + 1) + " - Set Time";
+  n++;
+  for (int i = 0; i < n_alarms; i++) {
+    modes[n] = String(n + 1) + " - Set Alarm " + String(i + 1);
+    n++;
+  }
+  for (int i = 0; i < n_menu_items; i++) {
+    modes[n] = String(n + 1) + " - " + menu_items[i];
+    n++;
+  }
+}
+
 void run_mode(int mode) {
   if (mode == 0){
     set_time();
+    return;
   }
-  else if (mode == 1 || mode == 2){
+  else if (mode <= n_alarms){
     set_alarm(mode - 1);
+    return;
   }
-  else if (mode == 3){
+
+  // Entries after the per-alarm ones, in menu_items order
+  mode -= n_alarms;
+  if (mode == 1){
     // Toggle alarm state
     alarm_enabled = !alarm_enabled;
     save_settings();
@@ -626,20 +893,29 @@ void run_mode(int mode) {
     print_line("Alarms " + String(alarm_enabled ? "enabled" : "disabled"), 0, 0, 2);
     delay(1500);
   }
-  else if (mode == 4){
+  else if (mode == 2){
     set_timezone();
   }
-  else if (mode == 5){
+  else if (mode == 3){
     view_alarms();
   }
-  else if (mode == 6){
+  else if (mode == 4){
     delete_alarm();
   }
+  else if (mode == 5){
+    view_diagnostics();
+  }
+  else if (mode == 6){
+    update_firmware();
+  }
 }
 
 void check_temp(){
   TempAndHumidity data = dhtSensor.getTempAndHumidity();
   bool warning = false;
+
+  last_temperature = data.temperature;
+  last_humidity = data.humidity;
   
   // Update with correct healthy ranges
   // Healthy Temperature: 24°C ≤ Temperature ≤ 32°C
@@ -765,6 +1041,33 @@ void set_timezone() {
   }
 }
 
+void draw_alarm_details(int alarm) {
+  display.clearDisplay();
+  display.setTextSize(2);
+  display.setCursor(0, 0);
+  display.print("Alarm ");
+  display.print(alarm+1);
+  display.print(":");
+
+  display.setCursor(0, 20);
+  // Format time with leading zeros
+  if (alarm_hours[alarm] < 10) display.print("0");
+  display.print(alarm_hours[alarm]);
+  display.print(":");
+  if (alarm_minutes[alarm] < 10) display.print("0");
+  display.print(alarm_minutes[alarm]);
+
+  display.setCursor(0, 40);
+  display.setTextSize(1);
+  display.print("Status: ");
+  display.print(alarm_triggered[alarm] ? "Triggered" : "Waiting");
+  display.setCursor(0, 50);
+  display.print("Repeat: ");
+  display.print(recurrence_describe(alarm_rules[alarm]));
+
+  display.display();
+}
+
 void view_alarms() {
   display.clearDisplay();
   
@@ -775,40 +1078,16 @@ void view_alarms() {
   }
   
   for (int i = 0; i < n_alarms; i++) {
-    display.clearDisplay();
-    display.setTextSize(2);
-    display.setCursor(0, 0);
-    display.print("Alarm ");
-    display.print(i+1);
-    display.print(":");
-    
-    display.setCursor(0, 20);
-    // Format time with leading zeros
-    if (alarm_hours[i] < 10) display.print("0");
-    display.print(alarm_hours[i]);
-    display.print(":");
-    if (alarm_minutes[i] < 10) display.print("0");
-    display.print(alarm_minutes[i]);
-    
-    display.setCursor(0, 40);
-    display.setTextSize(1);
-    display.print("Status: ");
-    display.print(alarm_triggered[i] ? "Triggered" : "Waiting");
-    display.setCursor(0, 50);
-    display.print("Repeat: ");
-    display.print(alarm_repeat[i] ? "Yes" : "No");
+    draw_alarm_details(i);
 
-    
-    display.display();
-    
     // Wait for button press to see next alarm or exit
     bool exitLoop = false;
     while (!exitLoop) {
-      if (digitalRead(PB_OK) == LOW) {
+      if (button_down<PB_OK>()) {
         delay(200);
         exitLoop = true; // Go to next alarm
       }
-      else if (digitalRead(PB_CANCEL) == LOW) {
+      else if (button_down<PB_CANCEL>()) {
         delay(200);
         return; // Exit to main menu
       }
@@ -816,29 +1095,33 @@ void view_alarms() {
   }
 }
 
+void draw_delete_alarm(int alarm) {
+  display.clearDisplay();
+  display.setTextSize(2);
+  display.setCursor(0, 0);
+  display.print("Alarm ");
+  display.print(alarm + 1);
+
+  display.setCursor(0, 20);
+  if (alarm_hours[alarm] < 10) display.print("0");
+  display.print(alarm_hours[alarm]);
+  display.print(":");
+  if (alarm_minutes[alarm] < 10) display.print("0");
+  display.print(alarm_minutes[alarm]);
+
+  display.setCursor(0, 45);
+  display.setTextSize(1);
+  display.print("UP/DOWN=Select OK=Delete");
+
+  display.display();
+}
+
 void delete_alarm() {
   int current_alarm = 0;
   
   while (true) {
-    display.clearDisplay();
-    display.setTextSize(2);
-    display.setCursor(0, 0);
-    display.print("Alarm ");
-    display.print(current_alarm + 1);
-    
-    display.setCursor(0, 20);
-    if (alarm_hours[current_alarm] < 10) display.print("0");
-    display.print(alarm_hours[current_alarm]);
-    display.print(":");
-    if (alarm_minutes[current_alarm] < 10) display.print("0");
-    display.print(alarm_minutes[current_alarm]);
-    
-    display.setCursor(0, 45);
-    display.setTextSize(1);
-    display.print("UP/DOWN=Select OK=Delete");
-    
-    display.display();
-    
+    draw_delete_alarm(current_alarm);
+
     int pressed = wait_for_button_press();
     
     if (pressed == PB_UP || pressed == PB_DOWN) {
@@ -849,6 +1132,8 @@ void delete_alarm() {
       alarm_hours[current_alarm] = 0;
       alarm_minutes[current_alarm] = 0;
       alarm_triggered[current_alarm] = false;
+      alarm_rules[current_alarm] = recurrence_default(0, 0, alarm_repeat[current_alarm], current_day);
+      schedule_dirty = true;
 
       save_settings();
       
@@ -863,6 +1148,157 @@ void delete_alarm() {
   }
 }
 
+void publish_dashboard() {
+  DashboardSnapshot snap;
+
+  snprintf(snap.clock, sizeof(snap.clock), "%02d:%02d:%02d", hours, minutes, seconds);
+  snprintf(snap.date, sizeof(snap.date), "%02d/%02d", days % 100, month % 100);
+  snap.temperature = last_temperature;
+  snap.humidity = last_humidity;
+  snap.alarms_enabled = alarm_enabled;
+
+  snap.n_alarms = min(n_alarms, WEB_MAX_ALARMS);
+  for (int i = 0; i < snap.n_alarms; i++) {
+    snap.alarms[i].hour = alarm_hours[i];
+    snap.alarms[i].minute = alarm_minutes[i];
+    snprintf(snap.alarms[i].repeat, sizeof(snap.alarms[i].repeat), "%s",
+             recurrence_describe(alarm_rules[i]).c_str());
+    snap.alarms[i].triggered = alarm_triggered[i];
+  }
+
+  snap.snooze_left_s = 0;
+  if (snooze_active) {
+    snap.snooze_left_s = (SNOOZE_DURATION - (millis() - snooze_start_time)) / 1000;
+  }
+
+  web_dashboard_publish(snap);
+}
+
+void view_diagnostics() {
+  while (true) {
+    if (time_discipline_update()) {
+      second_tick_rearm();
+    }
+    TimeSyncStats stats = time_discipline_stats();
+    TickStats tick = second_tick_stats();
+
+    display.clearDisplay();
+    display.setTextSize(1);
+    display.setTextColor(WHITE);
+
+    display.setCursor(0, 0);
+    display.print("NTP syncs: ");
+    display.print(stats.sync_count);
+
+    display.setCursor(0, 9);
+    display.print("Drift: ");
+    display.print(stats.drift_ppm, 1);
+    display.print(" +-");
+    display.print(stats.drift_spread_ppm, 1);
+    display.print("ppm");
+
+    display.setCursor(0, 18);
+    display.print("Last offset: ");
+    display.print(stats.last_offset_ms);
+    display.print("ms");
+
+    display.setCursor(0, 27);
+    display.print("Interval: ");
+    display.print(stats.sync_interval_s / 60);
+    display.print("min");
+
+    display.setCursor(0, 36);
+    display.print("Since sync: ");
+    display.print(stats.since_sync_s / 60);
+    display.print("min");
+
+    display.setCursor(0, 45);
+    display.print("Error <= ");
+    if (time_discipline_synced()) {
+      display.print(stats.error_bound_ms);
+      display.print("ms");
+    } else {
+      display.print("unsynced");
+    }
+
+    // Mean timer phase and render latency; snprintf keeps it to one row
+    char row[22];
+    snprintf(row, sizeof(row), "Tick %.1f draw %.1fms",
+             tick.mean_phase_us / 1000.0, tick.mean_render_us / 1000.0);
+    display.setCursor(0, 54);
+    display.print(row);
+
+    display.display();
+
+    // Refresh twice a second until OK or CANCEL
+    unsigned long shown = millis();
+    while (millis() - shown < 500) {
+      if (button_down<PB_OK>() || button_down<PB_CANCEL>()) {
+        delay(200);
+        return;
+      }
+    }
+  }
+}
+
+void show_ota_progress(size_t written, size_t total) {
+  // Redraw only every 16 KB so the I2C flush doesn't slow the download
+  static size_t last_drawn = 0;
+  if (written < last_drawn) last_drawn = 0;
+  if (written - last_drawn < 16384 && written != total) return;
+  last_drawn = written;
+
+  display.fillRect(0, 40, SCREEN_WIDTH, 10, BLACK);
+  display.drawRect(0, 40, SCREEN_WIDTH, 10, WHITE);
+  display.fillRect(2, 42, (SCREEN_WIDTH - 4) * written / total, 6, WHITE);
+  display.display();
+}
+
+void update_firmware() {
+  display.clearDisplay();
+  print_line("Updating...", 0, 0, 2);
+  print_line(String("Running ") + ota_image_key(), 0, 20, 1);
+
+  OtaResult result = ota_check_and_apply(show_ota_progress);
+
+  display.clearDisplay();
+  if (result == OTA_APPLIED) {
+    print_line("Update OK", 0, 0, 2);
+    print_line("Restarting...", 0, 30, 1);
+    delay(1500);
+    save_warm_state();  // a software reset comes back up warm
+    ESP.restart();
+  }
+  else if (result == OTA_NO_UPDATE) {
+    print_line("Up to date", 0, 0, 2);
+  }
+  else {
+    print_line("Update failed", 0, 0, 2);
+    print_line(ota_last_error(), 0, 30, 1);
+  }
+  delay(2000);
+}
+
+void load_settings() {
+  prefs.begin("medibox", true); // true = read-only
+  UTC_OFFSET = prefs.getFloat("tz_offset", 0.0);  // default 0.0
+  alarm_enabled = prefs.getBool("alarm_en", true);
+  for (int i = 0; i < n_alarms; i++) {
+    alarm_hours[i] = prefs.getInt(("a_hr" + String(i)).c_str(), 0);
+    alarm_minutes[i] = prefs.getInt(("a_min" + String(i)).c_str(), 0);
+    alarm_triggered[i] = false; // nothing to go on after a cold boot
+    alarm_repeat[i] = prefs.getBool(("a_rep" + String(i)).c_str(), true);
+    String rule_key = "a_rule" + String(i);
+    if (prefs.getBytes(rule_key.c_str(), &alarm_rules[i], sizeof(RecurrenceRule)) != sizeof(RecurrenceRule)) {
+      // Settings saved before recurrence rules existed
+      alarm_rules[i] = recurrence_default(alarm_hours[i], alarm_minutes[i], alarm_repeat[i], 0);
+    }
+    alarm_tune[i] = prefs.getInt(("a_tune" + String(i)).c_str(), i % n_tunes);
+    if (alarm_tune[i] < 0 || alarm_tune[i] >= n_tunes) alarm_tune[i] = 0;
+  }
+  prefs.end();
+}
+
 void save_settings() {
   prefs.begin("medibox", false);  // false = write mode
 
@@ -872,10 +1308,197 @@ void save_settings() {
     prefs.putInt(("a_hr" + String(i)).c_str(), alarm_hours[i]);
     prefs.putInt(("a_min" + String(i)).c_str(), alarm_minutes[i]);
     prefs.putBool(("a_rep" + String(i)).c_str(), alarm_repeat[i]);
+    prefs.putBytes(("a_rule" + String(i)).c_str(), &alarm_rules[i], sizeof(RecurrenceRule));
+    prefs.putInt(("a_tune" + String(i)).c_str(), alarm_tune[i]);
   }
 
   prefs.end();
+
+  // A warm boot takes the settings from the snapshot, so keep it in step
+  // with NVS even while the menu is still open
+  save_warm_state();
+}
+
+// Called once per second and after anything that changes alarm state, so a
+// reset loses at most the last second
+void save_warm_state() {
+  WarmState state = {};
+
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  state.epoch_us = (int64_t)now.tv_sec * 1000000 + now.tv_usec;
+  state.temperature = last_temperature;
+  state.humidity = last_humidity;
+
+  state.snooze_alarm = -1;
+  if (snooze_active) {
+    unsigned long elapsed = millis() - snooze_start_time;
+    state.snooze_left_ms = elapsed < SNOOZE_DURATION ? SNOOZE_DURATION - elapsed : 0;
+    state.snooze_alarm = snooze_alarm_id;
+  }
+
+  state.n_alarms = n_alarms;
+  state.alarm_enabled = alarm_enabled;
+  state.utc_offset = UTC_OFFSET;
+  for (int i = 0; i < n_alarms; i++) {
+    if (alarm_triggered[i]) state.triggered |= 1 << i;
+    if (alarm_repeat[i]) state.alarm_repeat |= 1 << i;
+    state.alarm_hours[i] = alarm_hours[i];
+    state.alarm_minutes[i] = alarm_minutes[i];
+    state.alarm_tune[i] = alarm_tune[i];
+    state.alarm_rules[i] = alarm_rules[i];
+  }
+
+  warm_state_save(state);
+}
+
+void restore_warm_state(const WarmState &state) {
+  UTC_OFFSET = state.utc_offset;
+  alarm_enabled = state.alarm_enabled;
+  for (int i = 0; i < n_alarms; i++) {
+    alarm_hours[i] = state.alarm_hours[i];
+    alarm_minutes[i] = state.alarm_minutes[i];
+    alarm_triggered[i] = state.triggered & (1 << i);
+    alarm_repeat[i] = state.alarm_repeat & (1 << i);
+    alarm_rules[i] = state.alarm_rules[i];
+    alarm_tune[i] = state.alarm_tune[i] < n_tunes ? state.alarm_tune[i] : 0;
+  }
+
+  last_temperature = state.temperature;
+  last_humidity = state.humidity;
+
+  if (state.snooze_alarm >= 0 && state.snooze_alarm < n_alarms) {
+    // millis() restarted from zero; the unsigned subtraction still leaves
+    // exactly snooze_left_ms until the snooze runs out
+    snooze_active = true;
+    snooze_alarm_id = state.snooze_alarm;
+    snooze_start_time = millis() - (SNOOZE_DURATION - state.snooze_left_ms);
+  }
+
+  // The clock may not have survived the reset; resume from the snapshot
+  // until NTP answers
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  if ((int64_t)now.tv_sec * 1000000 + now.tv_usec < state.epoch_us) {
+    struct timeval tv = { (time_t)(state.epoch_us / 1000000), (suseconds_t)(state.epoch_us % 1000000) };
+    settimeofday(&tv, NULL);
+  }
+}
+
+#if defined(RENDER_BENCH) || defined(RENDER_TEST)
+// Fixed state, screen list and per-screen stats shared by the render benchmark
+// below and the host-side render test (test/test_render, env:native). Both
+// compare the framebuffers with the golden images in test/golden.
+
+void bench_fixed_state() {
+  hours = 8;
+  minutes = 30;
+  seconds = 15;
+  days = 18;
+  month = 10;
+  UTC_OFFSET = 5.5;
+  alarm_enabled = true;
+  last_temperature = 27.5;
+  last_humidity = 70;
+  snooze_active = false;
+  for (int i = 0; i < n_alarms; i++) {
+    alarm_hours[i] = 8 + i;
+    alarm_minutes[i] = 30;
+    alarm_triggered[i] = (i == 0);
+    alarm_repeat[i] = (i != 1);
+    alarm_rules[i] = recurrence_default(alarm_hours[i], alarm_minutes[i], alarm_repeat[i], 0);
+  }
 }
 
+void bench_main_display(int) { draw_main_display(); }
+void bench_ring_alarm(int) { draw_ring_alarm(); }
+
+typedef void (*BenchRender)(int arg);
+
+// Calls visit(name, render, arg) for every screen, in a fixed order
+void for_each_bench_screen(void (*visit)(const char *name, BenchRender render, int arg)) {
+  visit("main_display", bench_main_display, 0);
+  visit("ring_alarm", bench_ring_alarm, 0);
+  for (int mode = 0; mode < max_modes; mode++) {
+    visit(("menu_" + String(mode + 1)).c_str(), draw_menu, mode);
+  }
+  for (int i = 0; i < n_alarms; i++) {
+    visit(("view_alarm_" + String(i + 1)).c_str(), draw_alarm_details, i);
+    visit(("delete_alarm_" + String(i + 1)).c_str(), draw_delete_alarm, i);
+  }
+}
 
+const int BENCH_FRAME_BYTES = Board::frame_bytes;
+uint8_t bench_previous[BENCH_FRAME_BYTES];
 
+int bench_popcount(uint8_t b) {
+  int n = 0;
+  while (b) {
+    n += b & 1;
+    b >>= 1;
+  }
+  return n;
+}
+
+// Draws one screen from the fixed state and prints its render time,
+// lit/changed pixels, flushes and the bytes that would go over I2C. The frame
+// is left in the display buffer.
+void bench_render(const char *name, BenchRender render, int arg) {
+  bench_fixed_state();
+  display.flushes = 0;
+
+  unsigned long start = micros();
+  render(arg);
+  unsigned long elapsed = micros() - start;
+
+  const uint8_t *frame = display.getBuffer();
+  int lit = 0;
+  int changed = 0;
+  uint32_t crc = 0xFFFFFFFF;
+  for (int i = 0; i < BENCH_FRAME_BYTES; i++) {
+    lit += bench_popcount(frame[i]);
+    changed += bench_popcount(frame[i] ^ bench_previous[i]);
+
+    crc ^= frame[i];
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  crc = ~crc;
+  memcpy(bench_previous, frame, BENCH_FRAME_BYTES);
+
+  uint32_t i2c_bytes = display.flushes * display.i2c_bytes_per_flush;
+
+  // 9 bit times per byte (8 data + ACK) at 400 kHz = 22.5 us
+  uint32_t i2c_us = i2c_bytes * 45 / 2;
+
+  Serial.printf("BENCH %s render_us=%lu lit=%d changed=%d flushes=%u i2c_bytes=%u i2c_us=%u crc=%08x\n",
+                name, elapsed, lit, changed, display.flushes, i2c_bytes, i2c_us, crc);
+}
+#endif
+
+#ifdef RENDER_BENCH
+// Render benchmark (env:render-bench). Draws every screen headless from the
+// fixed state and prints its BENCH line, followed by the raw framebuffer as
+// hex for tools/render_golden.py.
+
+void bench_screen(const char *name, BenchRender render, int arg) {
+  bench_render(name, render, arg);
+
+  const uint8_t *frame = display.getBuffer();
+  Serial.printf("FRAME %s ", name);
+  for (int i = 0; i < BENCH_FRAME_BYTES; i++) {
+    Serial.printf("%02x", frame[i]);
+  }
+  Serial.println();
+}
+
+void run_render_bench() {
+  display.headless = true;
+  memset(bench_previous, 0, sizeof(bench_previous));
+
+  Serial.println("BENCH begin");
+  for_each_bench_screen(bench_screen);
+  Serial.println("BENCH end");
+
+  display.headless = false;
+}
+#endif
@@ -0,0 +1,337 @@
+#include "ota_update.h"
+#include "log.h"
+
+#include <HTTPClient.h>
+#include <Update.h>
+#include <WiFi.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <rom/miniz.h>
+
+// Patch format (little endian):
+//   header  "MBDP", version, 3 reserved bytes,
+//           source size, source CRC32, target size, target CRC32
+//   ops     COPY   varint offset, varint length   bytes from the running image
+//           INSERT varint length, <length bytes>   new bytes
+//           FILL   varint length, <byte>           run of one byte value
+//           END
+// Version 1 sends the ops as they are, version 2 as one zlib stream. Both are
+// accepted, so older firmware can still be served version 1 patches.
+const uint32_t PATCH_MAGIC = 0x5044424D;  // "MBDP"
+const uint8_t PATCH_VERSION_RAW = 1;
+const uint8_t PATCH_VERSION_DEFLATE = 2;
+
+const uint8_t OP_END = 0;
+const uint8_t OP_COPY = 1;
+const uint8_t OP_INSERT = 2;
+const uint8_t OP_FILL = 3;
+
+const size_t CHUNK_SIZE = 1024;
+const unsigned long STREAM_TIMEOUT = 5000;
+
+struct __attribute__((packed)) PatchHeader {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t reserved[3];
+  uint32_t source_size;
+  uint32_t source_crc;
+  uint32_t target_size;
+  uint32_t target_crc;
+};
+
+static const char *last_error = "";
+static uint8_t chunk[CHUNK_SIZE];
+
+// Op stream source. A deflated stream is inflated through the ROM copy of
+// miniz into a 32 KB ring that doubles as the LZ dictionary; both buffers
+// only exist while a patch is being applied
+static Stream *patch_in = NULL;
+static tinfl_decompressor *inflater = NULL;
+static uint8_t *ring = NULL;
+static size_t ring_next = 0;      // where the inflater writes next
+static size_t ring_read = 0;      // first inflated byte not yet consumed
+static size_t ring_avail = 0;
+static bool inflate_done = false;
+
+static uint8_t in_buf[512];
+static size_t in_pos = 0;
+static size_t in_len = 0;
+static bool in_eof = false;
+
+// Output state for the image being written
+static size_t written = 0;
+static size_t target_size = 0;
+static uint32_t target_crc = 0;
+static OtaProgressCallback progress_cb = NULL;
+
+static OtaResult fail(const char *reason) {
+  last_error = reason;
+  LOG_E("OTA failed: %s", reason);
+  return OTA_FAILED;
+}
+
+static bool inflate_begin() {
+  inflater = (tinfl_decompressor *)malloc(sizeof(tinfl_decompressor));
+  ring = (uint8_t *)malloc(TINFL_LZ_DICT_SIZE);
+  if (inflater == NULL || ring == NULL) return false;
+
+  tinfl_init(inflater);
+  ring_next = ring_read = ring_avail = 0;
+  inflate_done = false;
+  in_pos = in_len = 0;
+  in_eof = false;
+  return true;
+}
+
+static void inflate_end() {
+  free(inflater);
+  free(ring);
+  inflater = NULL;
+  ring = NULL;
+}
+
+// Inflates the next piece into the ring. Only called once everything
+// inflated before has been consumed, since the ring is overwritten
+static bool inflate_more() {
+  while (ring_avail == 0) {
+    if (inflate_done) return false;
+
+    if (in_pos == in_len && !in_eof) {
+      in_len = patch_in->readBytes(in_buf, sizeof(in_buf));
+      in_pos = 0;
+      in_eof = in_len == 0;
+    }
+
+    size_t in_bytes = in_len - in_pos;
+    size_t out_bytes = TINFL_LZ_DICT_SIZE - ring_next;
+    int flags = TINFL_FLAG_PARSE_ZLIB_HEADER | (in_eof ? 0 : TINFL_FLAG_HAS_MORE_INPUT);
+    tinfl_status status = tinfl_decompress(inflater, in_buf + in_pos, &in_bytes,
+                                           ring, ring + ring_next, &out_bytes, flags);
+    in_pos += in_bytes;
+
+    if (status < TINFL_STATUS_DONE) return false;  // corrupt stream or bad Adler-32
+    if (status == TINFL_STATUS_NEEDS_MORE_INPUT && in_eof) return false;
+    inflate_done = status == TINFL_STATUS_DONE;
+
+    ring_read = ring_next;
+    ring_avail = out_bytes;
+    ring_next = (ring_next + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+  }
+  return true;
+}
+
+// After OP_END: inflates through the zlib trailer, so its Adler-32 is checked
+// even when it arrives in a later read, and rejects anything after OP_END
+static bool inflate_finish() {
+  if (ring_avail > 0 || inflate_more()) return false;
+  return inflate_done;
+}
+
+static bool read_exact(uint8_t *dst, size_t n) {
+  if (inflater == NULL) {
+    return patch_in->readBytes(dst, n) == n;
+  }
+
+  while (n > 0) {
+    if (ring_avail == 0 && !inflate_more()) return false;
+    size_t len = min(n, ring_avail);
+    memcpy(dst, ring + ring_read, len);
+    ring_read += len;
+    ring_avail -= len;
+    dst += len;
+    n -= len;
+  }
+  return true;
+}
+
+static bool read_varint(uint32_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 32; shift += 7) {
+    uint8_t b;
+    if (!read_exact(&b, 1)) return false;
+    value |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+static bool write_out(const uint8_t *data, size_t len) {
+  if (written + len > target_size) return false;
+  if (Update.write((uint8_t *)data, len) != len) return false;
+
+  target_crc = esp_rom_crc32_le(target_crc, data, len);
+  written += len;
+  if (progress_cb) progress_cb(written, target_size);
+  return true;
+}
+
+static uint32_t partition_crc(const esp_partition_t *part, size_t size) {
+  uint32_t crc = 0;
+  for (size_t offset = 0; offset < size; offset += CHUNK_SIZE) {
+    size_t len = min(CHUNK_SIZE, size - offset);
+    if (esp_partition_read(part, offset, chunk, len) != ESP_OK) return 0;
+    crc = esp_rom_crc32_le(crc, chunk, len);
+  }
+  return crc;
+}
+
+static bool apply_ops(const esp_partition_t *source, size_t source_size) {
+  while (true) {
+    uint8_t op;
+    if (!read_exact(&op, 1)) return false;
+
+    if (op == OP_END) {
+      return inflater == NULL || inflate_finish();
+    }
+
+    else if (op == OP_COPY) {
+      uint32_t offset, length;
+      if (!read_varint(offset) || !read_varint(length)) return false;
+      if (offset + length > source_size) return false;
+
+      while (length > 0) {
+        size_t len = min((size_t)length, CHUNK_SIZE);
+        if (esp_partition_read(source, offset, chunk, len) != ESP_OK) return false;
+        if (!write_out(chunk, len)) return false;
+        offset += len;
+        length -= len;
+      }
+    }
+
+    else if (op == OP_INSERT) {
+      uint32_t length;
+      if (!read_varint(length)) return false;
+
+      while (length > 0) {
+        size_t len = min((size_t)length, CHUNK_SIZE);
+        if (!read_exact(chunk, len)) return false;
+        if (!write_out(chunk, len)) return false;
+        length -= len;
+      }
+    }
+
+    else if (op == OP_FILL) {
+      uint32_t length;
+      uint8_t value;
+      if (!read_varint(length) || !read_exact(&value, 1)) return false;
+
+      memset(chunk, value, min((size_t)length, CHUNK_SIZE));
+      while (length > 0) {
+        size_t len = min((size_t)length, CHUNK_SIZE);
+        if (!write_out(chunk, len)) return false;
+        length -= len;
+      }
+    }
+
+    else {
+      return false;
+    }
+  }
+}
+
+OtaResult ota_check_and_apply(OtaProgressCallback progress) {
+  if (WiFi.status() != WL_CONNECTED) {
+    return fail("no Wi-Fi");
+  }
+
+  HTTPClient http;
+  String url = String(OTA_SERVER) + "/medbox-" + ota_image_key() + ".mbdp";
+  http.begin(url);
+  int code = http.GET();
+
+  if (code == HTTP_CODE_NOT_FOUND) {
+    http.end();
+    return OTA_NO_UPDATE;
+  }
+  if (code != HTTP_CODE_OK) {
+    http.end();
+    return fail("server error");
+  }
+
+  Stream *in = http.getStreamPtr();
+  in->setTimeout(STREAM_TIMEOUT);
+
+  patch_in = in;
+  PatchHeader header;
+  if (!read_exact((uint8_t *)&header, sizeof(header)) || header.magic != PATCH_MAGIC ||
+      (header.version != PATCH_VERSION_RAW && header.version != PATCH_VERSION_DEFLATE)) {
+    http.end();
+    return fail("bad patch header");
+  }
+
+  // The patch only makes sense against the exact image it was made from
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  if (header.source_size > running->size ||
+      partition_crc(running, header.source_size) != header.source_crc) {
+    http.end();
+    return fail("patch is for another image");
+  }
+
+  if (!Update.begin(header.target_size)) {
+    http.end();
+    return fail(Update.errorString());
+  }
+
+  written = 0;
+  target_size = header.target_size;
+  target_crc = 0;
+  progress_cb = progress;
+
+  if (header.version == PATCH_VERSION_DEFLATE && !inflate_begin()) {
+    inflate_end();
+    Update.abort();
+    http.end();
+    return fail("out of memory");
+  }
+
+  bool ok = apply_ops(running, header.source_size);
+  inflate_end();
+  http.end();
+
+  if (!ok || written != target_size) {
+    Update.abort();
+    return fail("patch stream broken");
+  }
+  if (target_crc != header.target_crc) {
+    Update.abort();
+    return fail("image CRC mismatch");
+  }
+  if (!Update.end()) {
+    return fail(Update.errorString());
+  }
+
+  LOG_I("OTA image written (%u bytes), reboot to apply", (unsigned)written);
+  return OTA_APPLIED;
+}
+
+const char *ota_image_key() {
+  static char key[17] = "";
+  if (key[0] == '\0') {
+    const esp_app_desc_t *app = esp_ota_get_app_description();
+    for (int i = 0; i < 8; i++) {
+      snprintf(key + 2 * i, 3, "%02x", app->app_elf_sha256[i]);
+    }
+  }
+  return key;
+}
+
+const char *ota_last_error() {
+  return last_error;
+}
+
+void ota_mark_healthy() {
+  esp_ota_img_states_t state;
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  if (esp_ota_get_state_partition(running, &state) == ESP_OK &&
+      state == ESP_OTA_IMG_PENDING_VERIFY) {
+    esp_ota_mark_app_valid_cancel_rollback();
+    LOG_I("OTA image confirmed");
+  }
+}
+
+// Keep a freshly updated image in pending-verify state until ota_mark_healthy()
+// instead of letting the Arduino core confirm it before setup() runs
+extern "C" bool verifyRollbackLater() {
+  return true;
+}
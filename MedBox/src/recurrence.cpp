@@ -0,0 +1,95 @@
+#include "recurrence.h"
+
+static const char WEEKDAY_LETTERS[] = "SMTWTFS";
+
+// Howard Hinnant's days_from_civil, valid for any proleptic Gregorian date
+int32_t days_from_civil(int year, int month, int day) {
+  year -= month <= 2;
+  int32_t era = (year >= 0 ? year : year - 399) / 400;
+  int32_t yoe = year - era * 400;
+  int32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+RecurrenceRule recurrence_default(int hour, int minute, bool repeat, int32_t today) {
+  RecurrenceRule rule;
+  memset(&rule, 0, sizeof(rule));
+  rule.kind = repeat ? RULE_DAILY : RULE_ONCE;
+  rule.hour = hour;
+  rule.minute = minute;
+  rule.weekdays = 0x7F;
+  rule.every_hours = 8;
+  rule.start_day = today;
+  return rule;
+}
+
+static bool in_date_range(const RecurrenceRule &rule, int32_t day) {
+  if (rule.start_day == START_DAY_PENDING) return false;
+  if (rule.n_days == 0) {
+    // Open-ended; every-N-hours still starts counting on start_day
+    return rule.kind != RULE_EVERY_N_HOURS || day >= rule.start_day;
+  }
+  return day >= rule.start_day && day < rule.start_day + rule.n_days;
+}
+
+void schedule_compile(ScheduleTable &table, const RecurrenceRule *rules, int n_rules, int32_t day) {
+  if (n_rules > MAX_RULES) n_rules = MAX_RULES;
+
+  table.day = day;
+  memset(table.weekday_mask, 0, sizeof(table.weekday_mask));
+  memset(table.minute_rules, 0, sizeof(table.minute_rules));
+  uint8_t range_mask = 0;
+
+  for (int r = 0; r < n_rules; r++) {
+    const RecurrenceRule &rule = rules[r];
+    uint8_t bit = 1 << r;
+
+    uint8_t days = rule.kind == RULE_WEEKDAYS ? rule.weekdays : 0x7F;
+    for (int w = 0; w < 7; w++) {
+      if (days & (1 << w)) table.weekday_mask[w] |= bit;
+    }
+
+    if (!in_date_range(rule, day)) continue;
+    range_mask |= bit;
+
+    int anchor = rule.hour * 60 + rule.minute;
+    if (anchor >= MINUTES_PER_DAY) continue;
+
+    if (rule.kind == RULE_EVERY_N_HOURS && rule.every_hours > 0) {
+      // Minutes since the first dose on start_day, so periods that don't
+      // divide 24 h carry over correctly from one day to the next
+      int32_t period = rule.every_hours * 60;
+      int64_t since_anchor = (int64_t)(day - rule.start_day) * MINUTES_PER_DAY - anchor;
+      int32_t first = since_anchor < 0 ? (int32_t)-since_anchor
+                                       : (int32_t)((period - since_anchor % period) % period);
+      for (int32_t m = first; m < MINUTES_PER_DAY; m += period) {
+        table.minute_rules[m] |= bit;
+      }
+    } else {
+      table.minute_rules[anchor] |= bit;
+    }
+  }
+
+  table.day_mask = table.weekday_mask[weekday_of(day)] & range_mask;
+}
+
+String recurrence_describe(const RecurrenceRule &rule) {
+  String text;
+  if (rule.kind == RULE_ONCE) {
+    return "Once";
+  } else if (rule.kind == RULE_DAILY) {
+    text = "Daily";
+  } else if (rule.kind == RULE_WEEKDAYS) {
+    for (int w = 0; w < 7; w++) {
+      text += (rule.weekdays & (1 << w)) ? WEEKDAY_LETTERS[w] : '-';
+    }
+  } else {
+    text = "Every " + String(rule.every_hours) + "h";
+  }
+
+  if (rule.n_days > 0) {
+    text += " " + String(rule.n_days) + "d";
+  }
+  return text;
+}
@@ -0,0 +1,94 @@
+#include "second_tick.h"
+
+#include <esp_timer.h>
+#include <sys/time.h>
+
+static esp_timer_handle_t tick_timer = NULL;
+
+static portMUX_TYPE tick_mux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool tick_pending = false;
+static time_t last_tick_second = 0;
+static TickStats stats = {};
+static time_t armed_second = 0;  // the boundary the timer was last armed for
+
+static void arm_for_next_second() {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  armed_second = now.tv_sec + 1;
+  esp_timer_start_once(tick_timer, 1000000 - now.tv_usec);
+}
+
+static void on_tick(void *arg) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+
+  // A backward slew makes the timer fire just before the boundary it was armed
+  // for; the clock still shows the second before it, so wait for the rest.
+  // Any fire at or past that boundary is a tick, however late
+  if (now.tv_sec == armed_second - 1) {
+    portENTER_CRITICAL(&tick_mux);
+    stats.early++;
+    portEXIT_CRITICAL(&tick_mux);
+    esp_timer_start_once(tick_timer, 1000000 - now.tv_usec);
+    return;
+  }
+
+  int32_t phase = now.tv_usec;
+  portENTER_CRITICAL(&tick_mux);
+  if (now.tv_sec != last_tick_second) {
+    if (tick_pending) stats.missed++;
+    tick_pending = true;
+    last_tick_second = now.tv_sec;
+
+    stats.ticks++;
+    stats.last_phase_us = phase;
+    if (phase > stats.max_phase_us) stats.max_phase_us = phase;
+    stats.mean_phase_us += (phase - stats.mean_phase_us) / 16;
+  }
+  portEXIT_CRITICAL(&tick_mux);
+
+  arm_for_next_second();
+}
+
+void second_tick_begin() {
+  esp_timer_create_args_t args = {};
+  args.callback = on_tick;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "second_tick";
+  esp_timer_create(&args, &tick_timer);
+  arm_for_next_second();
+}
+
+void second_tick_rearm() {
+  if (tick_timer == NULL) return;
+  esp_timer_stop(tick_timer);
+  arm_for_next_second();
+}
+
+bool second_tick_take(time_t &second) {
+  if (!tick_pending) return false;
+  portENTER_CRITICAL(&tick_mux);
+  tick_pending = false;
+  second = last_tick_second;
+  portEXIT_CRITICAL(&tick_mux);
+
+  // Latency as seen by the renderer, which is what the display shows
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  int64_t render_us = (int64_t)(now.tv_sec - second) * 1000000 + now.tv_usec;
+  if (render_us < 0) render_us = 0;
+  if (render_us > INT32_MAX) render_us = INT32_MAX;
+
+  portENTER_CRITICAL(&tick_mux);
+  stats.last_render_us = (int32_t)render_us;
+  stats.mean_render_us += (stats.last_render_us - stats.mean_render_us) / 16;
+  portEXIT_CRITICAL(&tick_mux);
+  return true;
+}
+
+TickStats second_tick_stats() {
+  portENTER_CRITICAL(&tick_mux);
+  TickStats copy = stats;
+  portEXIT_CRITICAL(&tick_mux);
+  return copy;
+}
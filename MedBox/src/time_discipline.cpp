@@ -0,0 +1,170 @@
+#include "time_discipline.h"
+#include "log.h"
+
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#include <sys/time.h>
+
+const unsigned long SLEW_PERIOD = 10 * 1000;           // re-apply the correction every 10 s
+const int64_t STEP_THRESHOLD_US = 30LL * 60 * 1000000; // adjtime() refuses larger offsets
+const int64_t MIN_DRIFT_SPAN_US = 10LL * 60 * 1000000; // shorter spans are dominated by NTP jitter
+
+// Filled in by the SNTP callback (lwIP task), consumed in loop()
+static portMUX_TYPE sync_mux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool sync_pending = false;
+static int64_t pending_ntp_us = 0;
+static int64_t pending_mono_us = 0;
+
+// Disciplined clock model: ntp = base_ntp + elapsed * (1 + drift_ppm / 1e6)
+static bool have_base = false;
+static int64_t base_mono_us = 0;
+static int64_t base_ntp_us = 0;
+
+static uint32_t sync_count = 0;
+static uint32_t drift_samples = 0;
+static float drift_ppm = 0.0;
+static float drift_spread_ppm = 0.0;
+static int32_t last_offset_ms = 0;
+static uint32_t sync_interval_s = NTP_MIN_SYNC_INTERVAL_S;
+
+static unsigned long last_slew = 0;
+
+static int64_t predicted_ntp_us(int64_t mono_us) {
+  int64_t elapsed = mono_us - base_mono_us;
+  return base_ntp_us + elapsed + (int64_t)(elapsed * (double)drift_ppm / 1e6);
+}
+
+static void on_time_sync(struct timeval *tv) {
+  int64_t mono = esp_timer_get_time();
+  portENTER_CRITICAL(&sync_mux);
+  pending_ntp_us = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec;
+  pending_mono_us = mono;
+  sync_pending = true;
+  portEXIT_CRITICAL(&sync_mux);
+}
+
+static void update_sync_interval() {
+  // Poll just often enough that the remaining drift uncertainty stays
+  // within the error budget, growing by at most 2x per good sync
+  float uncertainty_ppm = drift_spread_ppm + NTP_DRIFT_FLOOR_PPM;
+  uint32_t target_s = (uint32_t)(NTP_ERROR_BUDGET_MS * 1000.0 / uncertainty_ppm);
+
+  uint32_t interval = sync_interval_s * 2;
+  if (interval > target_s) interval = target_s;
+  if (interval < NTP_MIN_SYNC_INTERVAL_S) interval = NTP_MIN_SYNC_INTERVAL_S;
+  if (interval > NTP_MAX_SYNC_INTERVAL_S) interval = NTP_MAX_SYNC_INTERVAL_S;
+
+  if (interval != sync_interval_s) {
+    sync_interval_s = interval;
+    // Takes effect once the current interval expires
+    sntp_set_sync_interval(sync_interval_s * 1000);
+  }
+}
+
+static void process_sample(int64_t ntp_us, int64_t mono_us) {
+  sync_count++;
+
+  if (!have_base) {
+    have_base = true;
+    base_ntp_us = ntp_us;
+    base_mono_us = mono_us;
+    return;
+  }
+
+  int64_t span = mono_us - base_mono_us;
+  last_offset_ms = (int32_t)((ntp_us - predicted_ntp_us(mono_us)) / 1000);
+
+  if (span >= MIN_DRIFT_SPAN_US) {
+    float sample_ppm = (float)((double)(ntp_us - base_ntp_us - span) * 1e6 / span);
+
+    if (drift_samples == 0) {
+      drift_ppm = sample_ppm;
+      drift_spread_ppm = fabsf(sample_ppm);  // nothing to compare against yet
+    } else {
+      // Settle quickly on the first samples, then average over the last few
+      float alpha = 1.0 / (drift_samples + 1);
+      if (alpha < 0.25) alpha = 0.25;
+      drift_spread_ppm += 0.25 * (fabsf(sample_ppm - drift_ppm) - drift_spread_ppm);
+      drift_ppm += alpha * (sample_ppm - drift_ppm);
+    }
+    drift_samples++;
+    update_sync_interval();
+  }
+
+  LOG_I("NTP sync %u: offset %d ms, drift %.2f ppm, next in %u s",
+        (unsigned)sync_count, (int)last_offset_ms, drift_ppm, (unsigned)sync_interval_s);
+
+  base_ntp_us = ntp_us;
+  base_mono_us = mono_us;
+}
+
+static void slew_system_clock() {
+  int64_t mono = esp_timer_get_time();
+  int64_t target_us = predicted_ntp_us(mono);
+
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  int64_t delta_us = target_us - ((int64_t)now.tv_sec * 1000000 + now.tv_usec);
+
+  if (delta_us > STEP_THRESHOLD_US || delta_us < -STEP_THRESHOLD_US) {
+    struct timeval tv = { (time_t)(target_us / 1000000), (suseconds_t)(target_us % 1000000) };
+    settimeofday(&tv, NULL);
+    return;
+  }
+
+  // Replaces any adjustment still outstanding, so this is the total correction
+  struct timeval adj = { (time_t)(delta_us / 1000000), (suseconds_t)(delta_us % 1000000) };
+  adjtime(&adj, NULL);
+}
+
+void time_discipline_begin() {
+  sntp_set_time_sync_notification_cb(on_time_sync);
+  sntp_set_sync_mode(SNTP_SYNC_MODE_SMOOTH);
+  sntp_set_sync_interval(sync_interval_s * 1000);
+}
+
+bool time_discipline_update() {
+  bool synced = false;
+  if (sync_pending) {
+    portENTER_CRITICAL(&sync_mux);
+    int64_t ntp_us = pending_ntp_us;
+    int64_t mono_us = pending_mono_us;
+    sync_pending = false;
+    portEXIT_CRITICAL(&sync_mux);
+
+    process_sample(ntp_us, mono_us);
+    synced = true;
+  }
+
+  unsigned long now = millis();
+  if (have_base && drift_samples > 0 && now - last_slew >= SLEW_PERIOD) {
+    last_slew = now;
+    slew_system_clock();
+  }
+  return synced;
+}
+
+bool time_discipline_synced() {
+  return have_base;
+}
+
+TimeSyncStats time_discipline_stats() {
+  TimeSyncStats stats;
+  stats.sync_count = sync_count;
+  stats.drift_ppm = drift_ppm;
+  stats.drift_spread_ppm = drift_spread_ppm;
+  stats.last_offset_ms = last_offset_ms;
+  stats.sync_interval_s = sync_interval_s;
+  stats.since_sync_s = 0;
+  stats.error_bound_ms = 0;
+
+  if (have_base) {
+    int64_t since_us = esp_timer_get_time() - base_mono_us;
+    stats.since_sync_s = since_us / 1000000;
+
+    // Unknown drift: assume a typical uncompensated crystal (+-50 ppm)
+    float uncertainty_ppm = drift_samples > 0 ? drift_spread_ppm + NTP_DRIFT_FLOOR_PPM : 50.0;
+    stats.error_bound_ms = (uint32_t)(since_us / 1000.0 * uncertainty_ppm / 1e6);
+  }
+  return stats;
+}
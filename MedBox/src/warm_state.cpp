@@ -0,0 +1,100 @@
+#include "warm_state.h"
+#include "log.h"
+
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+#include <stddef.h>
+
+const uint32_t WARM_MAGIC = 0x5357424D;  // "MBWS"
+
+struct WarmRecord {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;
+  uint32_t crc;       // of everything from seq on
+  uint32_t seq;       // the newer of the two valid records wins
+  WarmState state;
+};
+
+const size_t CRC_OFFSET = offsetof(WarmRecord, seq);
+
+// Not cleared by the startup code, so whatever the last run wrote is still here
+static RTC_NOINIT_ATTR WarmRecord records[2];
+static uint32_t next_seq = 0;
+
+static uint32_t record_crc(const WarmRecord &r) {
+  return esp_rom_crc32_le(0, (const uint8_t *)&r + CRC_OFFSET, sizeof(WarmRecord) - CRC_OFFSET);
+}
+
+static bool record_valid(const WarmRecord &r) {
+  return r.magic == WARM_MAGIC && r.version == WARM_STATE_VERSION &&
+         r.size == sizeof(WarmState) && r.crc == record_crc(r);
+}
+
+// Resets that leave RTC slow memory powered
+static bool warm_reset() {
+  switch (esp_reset_reason()) {
+    case ESP_RST_SW:
+    case ESP_RST_PANIC:
+    case ESP_RST_INT_WDT:
+    case ESP_RST_TASK_WDT:
+    case ESP_RST_WDT:
+    case ESP_RST_BROWNOUT:
+    case ESP_RST_DEEPSLEEP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+const char *warm_state_reset_reason() {
+  switch (esp_reset_reason()) {
+    case ESP_RST_POWERON:   return "power-on";
+    case ESP_RST_EXT:       return "external";
+    case ESP_RST_SW:        return "software";
+    case ESP_RST_PANIC:     return "panic";
+    case ESP_RST_INT_WDT:   return "interrupt watchdog";
+    case ESP_RST_TASK_WDT:  return "task watchdog";
+    case ESP_RST_WDT:       return "watchdog";
+    case ESP_RST_DEEPSLEEP: return "deep sleep";
+    case ESP_RST_BROWNOUT:  return "brown-out";
+    default:                return "unknown";
+  }
+}
+
+bool warm_state_load(WarmState &state) {
+  const WarmRecord *newest = NULL;
+  if (warm_reset()) {
+    for (const WarmRecord &r : records) {
+      if (record_valid(r) && (newest == NULL || (int32_t)(r.seq - newest->seq) > 0)) {
+        newest = &r;
+      }
+    }
+  }
+
+  if (newest == NULL) {
+    // Cold boot: make sure leftovers can never be mistaken for a snapshot later
+    memset(records, 0, sizeof(records));
+    next_seq = 0;
+    LOG_I("Cold boot (%s reset)", warm_state_reset_reason());
+    return false;
+  }
+
+  state = newest->state;
+  next_seq = newest->seq + 1;
+  LOG_I("Warm restart (%s reset), snapshot %u restored",
+        warm_state_reset_reason(), (unsigned)newest->seq);
+  return true;
+}
+
+void warm_state_save(const WarmState &state) {
+  // Overwrite the older record; the newer one stays valid until this completes
+  WarmRecord &r = records[next_seq & 1];
+  r.magic = WARM_MAGIC;
+  r.version = WARM_STATE_VERSION;
+  r.size = sizeof(WarmState);
+  r.seq = next_seq;
+  memcpy(&r.state, &state, sizeof(WarmState));
+  r.crc = record_crc(r);
+  next_seq++;
+}
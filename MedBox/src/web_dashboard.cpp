@@ -0,0 +1,186 @@
+#include "web_dashboard.h"
+
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+
+#include "dashboard_html.h"
+
+static AsyncWebServer server(80);
+static AsyncWebSocket ws("/ws");
+
+// What every connected client has been sent so far. Only advanced once a
+// message is actually queued, so a busy client delays a change but never
+// loses it
+static DashboardSnapshot last_sent;
+
+// Bumped by the AsyncTCP task on each connect; a full push is due until
+// publish has sent one covering the latest connect
+static volatile uint32_t connects = 0;
+static uint32_t connects_pushed = 0;
+
+// Climate history, written from loop() and read from the AsyncTCP task
+struct HistorySample {
+  int16_t temperature_x10;
+  int16_t humidity_x10;
+};
+
+static portMUX_TYPE history_mux = portMUX_INITIALIZER_UNLOCKED;
+static HistorySample history[WEB_HISTORY_LEN];
+static int history_head = 0;
+static int history_count = 0;
+static unsigned long last_sample = 0;
+static bool sampled_once = false;
+static HistorySample pending_sample;     // newest sample not pushed yet
+static bool sample_pending = false;
+
+static void on_ws_event(AsyncWebSocket *server, AsyncWebSocketClient *client,
+                        AwsEventType type, void *arg, uint8_t *data, size_t len) {
+  if (type == WS_EVT_CONNECT) {
+    if (server->count() > WEB_MAX_CLIENTS) {
+      client->close();
+      return;
+    }
+    // The next publish sends every field so the new client starts complete
+    connects = connects + 1;
+  }
+}
+
+static void handle_history(AsyncWebServerRequest *request) {
+  static HistorySample copy[WEB_HISTORY_LEN];
+  int count, head;
+
+  portENTER_CRITICAL(&history_mux);
+  memcpy(copy, history, sizeof(history));
+  count = history_count;
+  head = history_head;
+  portEXIT_CRITICAL(&history_mux);
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  response->print('[');
+  for (int i = 0; i < count; i++) {
+    const HistorySample &s = copy[(head - count + i + WEB_HISTORY_LEN) % WEB_HISTORY_LEN];
+    if (i) response->print(',');
+    response->printf("[%.1f,%.1f]", s.temperature_x10 / 10.0, s.humidity_x10 / 10.0);
+  }
+  response->print(']');
+  request->send(response);
+}
+
+static void record_history(const DashboardSnapshot &snapshot) {
+  unsigned long now = millis();
+  if (sampled_once && now - last_sample < WEB_HISTORY_PERIOD_MS) return;
+  if (isnan(snapshot.temperature) || isnan(snapshot.humidity)) return;
+  sampled_once = true;
+  last_sample = now;
+
+  HistorySample s = { (int16_t)lroundf(snapshot.temperature * 10),
+                      (int16_t)lroundf(snapshot.humidity * 10) };
+
+  portENTER_CRITICAL(&history_mux);
+  history[history_head] = s;
+  history_head = (history_head + 1) % WEB_HISTORY_LEN;
+  if (history_count < WEB_HISTORY_LEN) history_count++;
+  portEXIT_CRITICAL(&history_mux);
+
+  pending_sample = s;
+  sample_pending = true;
+}
+
+static bool alarms_changed(const DashboardSnapshot &a, const DashboardSnapshot &b) {
+  if (a.n_alarms != b.n_alarms) return true;
+  for (int i = 0; i < a.n_alarms; i++) {
+    if (a.alarms[i].hour != b.alarms[i].hour || a.alarms[i].minute != b.alarms[i].minute ||
+        strcmp(a.alarms[i].repeat, b.alarms[i].repeat) != 0 || a.alarms[i].triggered != b.alarms[i].triggered) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void web_dashboard_begin() {
+  ws.onEvent(on_ws_event);
+  server.addHandler(&ws);
+
+  server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
+    AsyncWebServerResponse *response =
+        request->beginResponse_P(200, "text/html", dashboard_html_gz, dashboard_html_gz_len);
+    response->addHeader("Content-Encoding", "gzip");
+    request->send(response);
+  });
+  server.on("/history.json", HTTP_GET, handle_history);
+  server.onNotFound([](AsyncWebServerRequest *request) {
+    request->send(404, "text/plain", "Not found");
+  });
+
+  server.begin();
+}
+
+void web_dashboard_publish(const DashboardSnapshot &snapshot) {
+  // Drops clients over the limit and frees closed ones
+  ws.cleanupClients(WEB_MAX_CLIENTS);
+  record_history(snapshot);
+
+  if (ws.count() == 0) {
+    // Whoever connects next gets a full push and fetches /history.json
+    last_sent = snapshot;
+    sample_pending = false;
+    return;
+  }
+
+  // A client's queue is full: keep the diff against last_sent for next time
+  if (!ws.availableForWriteAll()) return;
+
+  uint32_t connects_seen = connects;
+  bool full = connects_seen != connects_pushed;
+
+  String json = "{\"v\":1";
+
+  if (full || strcmp(snapshot.clock, last_sent.clock) != 0) {
+    json += ",\"clock\":\"" + String(snapshot.clock) + "\"";
+  }
+  if (full || strcmp(snapshot.date, last_sent.date) != 0) {
+    json += ",\"date\":\"" + String(snapshot.date) + "\"";
+  }
+  if (!isnan(snapshot.temperature) &&
+      (full || fabsf(snapshot.temperature - last_sent.temperature) >= 0.05)) {
+    json += ",\"temp\":" + String(snapshot.temperature, 1);
+  }
+  if (!isnan(snapshot.humidity) &&
+      (full || fabsf(snapshot.humidity - last_sent.humidity) >= 0.5)) {
+    json += ",\"hum\":" + String(snapshot.humidity, 0);
+  }
+  if (full || snapshot.alarms_enabled != last_sent.alarms_enabled) {
+    json += ",\"alarm_en\":" + String(snapshot.alarms_enabled ? "true" : "false");
+  }
+  if (full || snapshot.snooze_left_s != last_sent.snooze_left_s) {
+    json += ",\"snooze\":" + String(snapshot.snooze_left_s);
+  }
+  if (full || alarms_changed(snapshot, last_sent)) {
+    json += ",\"alarms\":[";
+    for (int i = 0; i < snapshot.n_alarms; i++) {
+      const DashboardAlarm &a = snapshot.alarms[i];
+      char item[80];
+      snprintf(item, sizeof(item), "%s{\"h\":%d,\"m\":%d,\"rep\":\"%s\",\"trig\":%s}",
+               i ? "," : "", a.hour, a.minute, a.repeat, a.triggered ? "true" : "false");
+      json += item;
+    }
+    json += "]";
+  }
+
+  if (sample_pending) {
+    char field[40];
+    snprintf(field, sizeof(field), ",\"sample\":[%.1f,%.1f]",
+             pending_sample.temperature_x10 / 10.0, pending_sample.humidity_x10 / 10.0);
+    json += field;
+  }
+  json += "}";
+
+  // Nothing but the version tag means nothing changed
+  if (json.length() > 7) {
+    ws.textAll(json);
+  }
+
+  last_sent = snapshot;
+  connects_pushed = connects_seen;
+  sample_pending = false;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+// Minimal Arduino core for env:native, where the render test runs on the build
+// machine. Adafruit_GFX/SSD1306 only need it to compile; the firmware screens
+// draw into the RAM framebuffer and never reach a bus. Time comes from the
+// host clock, GPIO reads as released, and serial output goes to stdout.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "WString.h"
+#include "Print.h"
+
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PROGMEM
+#define IRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+#define F(s) ((const __FlashStringHelper *)(s))
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#endif
+#ifndef pgm_read_dword
+#define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+#endif
+#ifndef pgm_read_pointer
+#define pgm_read_pointer(addr) ((void *)pgm_read_dword(addr))
+#endif
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+using std::max;
+using std::min;
+
+inline unsigned long micros() {
+  using namespace std::chrono;
+  static const steady_clock::time_point start = steady_clock::now();
+  return (unsigned long)duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void delayMicroseconds(unsigned int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+inline void yield() {}
+
+// Buttons are active-low, so a floating HIGH reads as released
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; }
+inline void tone(uint8_t, unsigned int, unsigned long = 0) {}
+inline void noTone(uint8_t) {}
+
+inline void configTime(long, int, const char *, const char * = nullptr, const char * = nullptr) {}
+inline bool getLocalTime(struct tm *info, uint32_t = 5000) {
+  time_t now = time(nullptr);
+  localtime_r(&now, info);
+  return info->tm_year > 2016 - 1900;
+}
+
+class Stream : public Print {
+ public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+  size_t readBytes(uint8_t *, size_t) { return 0; }
+  void setTimeout(unsigned long) {}
+  void flush() { fflush(stdout); }
+  using Print::write;
+};
+
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  void setTxBufferSize(size_t) {}
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+  using Print::write;
+  operator bool() const { return true; }
+};
+
+inline HardwareSerial Serial;
+
+class EspClass {
+ public:
+  void restart() { exit(0); }
+  uint32_t getFreeHeap() { return 0; }
+};
+
+inline EspClass ESP;
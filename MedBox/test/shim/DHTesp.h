@@ -0,0 +1,19 @@
+#pragma once
+
+// DHT sensor for env:native: no sensor, so readings are NAN as on a board
+// whose DHT does not answer.
+
+#include "Arduino.h"
+
+struct TempAndHumidity {
+  float temperature;
+  float humidity;
+};
+
+class DHTesp {
+ public:
+  enum DHT_MODEL_t { AUTO_DETECT, DHT11, DHT22, AM2302, RHT03 };
+
+  void setup(uint8_t, DHT_MODEL_t) {}
+  TempAndHumidity getTempAndHumidity() { return { NAN, NAN }; }
+};
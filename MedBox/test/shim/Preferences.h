@@ -0,0 +1,21 @@
+#pragma once
+
+// NVS for env:native: empty, so every read returns its default.
+
+#include "Arduino.h"
+
+class Preferences {
+ public:
+  bool begin(const char *, bool = false) { return true; }
+  void end() {}
+
+  float getFloat(const char *, float value = 0) { return value; }
+  bool getBool(const char *, bool value = false) { return value; }
+  int32_t getInt(const char *, int32_t value = 0) { return value; }
+  size_t getBytes(const char *, void *, size_t) { return 0; }
+
+  size_t putFloat(const char *, float) { return sizeof(float); }
+  size_t putBool(const char *, bool) { return 1; }
+  size_t putInt(const char *, int32_t) { return sizeof(int32_t); }
+  size_t putBytes(const char *, const void *, size_t len) { return len; }
+};
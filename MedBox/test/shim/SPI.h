@@ -0,0 +1,35 @@
+#pragma once
+
+// SPI for env:native. Adafruit_GFX and BusIO compile their SPI displays
+// unconditionally, so the types have to exist; nothing here is ever called.
+
+#include "Arduino.h"
+
+#define SPI_HAS_TRANSACTION 1
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+class SPISettings {
+ public:
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+ public:
+  void begin() {}
+  void end() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  void setBitOrder(uint8_t) {}
+  void setDataMode(uint8_t) {}
+  void setClockDivider(uint32_t) {}
+  uint8_t transfer(uint8_t) { return 0; }
+  void transfer(void *, size_t) {}
+  uint16_t transfer16(uint16_t) { return 0; }
+  void transferBytes(const uint8_t *, uint8_t *, uint32_t) {}
+};
+
+inline SPIClass SPI;
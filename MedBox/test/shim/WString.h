@@ -0,0 +1,52 @@
+#pragma once
+
+// Arduino String for the host build, enough for the firmware's screens.
+// Number formatting follows the ESP32 core so rendered text matches.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+class __FlashStringHelper;
+
+class String {
+ public:
+  String(const char *c = "") : s(c ? c : "") {}
+  String(const std::string &c) : s(c) {}
+  explicit String(char c) : s(1, c) {}
+  String(int v) : s(std::to_string(v)) {}
+  String(unsigned v) : s(std::to_string(v)) {}
+  String(long v) : s(std::to_string(v)) {}
+  String(unsigned long v) : s(std::to_string(v)) {}
+  String(float v, unsigned int decimals = 2) : s(format_float(v, decimals)) {}
+  String(double v, unsigned int decimals = 2) : s(format_float(v, decimals)) {}
+
+  const char *c_str() const { return s.c_str(); }
+  unsigned int length() const { return s.size(); }
+  char operator[](unsigned int i) const { return i < s.size() ? s[i] : 0; }
+  void reserve(unsigned int n) { s.reserve(n); }
+
+  String &operator+=(const String &o) { s += o.s; return *this; }
+  String &operator+=(const char *o) { s += o; return *this; }
+  String &operator+=(char o) { s += o; return *this; }
+  bool operator==(const String &o) const { return s == o.s; }
+  bool operator!=(const String &o) const { return s != o.s; }
+
+  friend String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+  friend String operator+(const String &a, const char *b) { return String(a.s + b); }
+  friend String operator+(const char *a, const String &b) { return String(a + b.s); }
+
+ private:
+  // dtostrf(value, decimals + 2, decimals) as used by the ESP32 core
+  static std::string format_float(double v, unsigned int decimals) {
+    if (isnan(v)) return "nan";
+    if (isinf(v)) return "inf";
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%*.*f", (int)decimals + 2, (int)decimals, v);
+    return buf;
+  }
+
+  std::string s;
+};
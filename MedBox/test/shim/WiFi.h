@@ -0,0 +1,23 @@
+#pragma once
+
+// Wi-Fi for env:native: never connects.
+
+#include "Arduino.h"
+
+#define WL_IDLE_STATUS  0
+#define WL_CONNECTED    3
+#define WL_DISCONNECTED 6
+
+class IPAddress {
+ public:
+  String toString() const { return "0.0.0.0"; }
+};
+
+class WiFiClass {
+ public:
+  int begin(const char *, const char * = nullptr, int32_t = 0) { return WL_DISCONNECTED; }
+  int status() { return WL_DISCONNECTED; }
+  IPAddress localIP() { return IPAddress(); }
+};
+
+inline WiFiClass WiFi;
@@ -0,0 +1,25 @@
+#pragma once
+
+// I2C for env:native: every transfer succeeds and goes nowhere. Screens
+// are rendered headless, so only display.begin() ever talks to the panel.
+
+#include "Arduino.h"
+
+class TwoWire : public Stream {
+ public:
+  bool begin() { return true; }
+  bool begin(int, int, uint32_t = 0) { return true; }
+  void end() {}
+  bool setClock(uint32_t) { return true; }
+  uint32_t getClock() { return 400000; }
+
+  void beginTransmission(uint8_t) {}
+  uint8_t endTransmission(bool = true) { return 0; }
+  uint8_t requestFrom(uint8_t, uint8_t, uint8_t = true) { return 0; }
+
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t *, size_t size) override { return size; }
+  using Print::write;
+};
+
+inline TwoWire Wire;
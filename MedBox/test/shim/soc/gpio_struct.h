@@ -0,0 +1,18 @@
+#pragma once
+
+// GPIO input registers read by button_down<>() (board_profile.h). All bits
+// set: every active-low button reads as released.
+
+#include <stdint.h>
+
+typedef struct {
+  volatile uint32_t in;
+  union {
+    struct {
+      uint32_t data : 8;
+    };
+    volatile uint32_t val;
+  } in1;
+} gpio_dev_t;
+
+inline gpio_dev_t GPIO = { 0xFFFFFFFF, { .val = 0xFFFFFFFF } };
@@ -0,0 +1,3 @@
+#pragma once
+
+// Adafruit_SSD1306.cpp includes this on every architecture it does not know
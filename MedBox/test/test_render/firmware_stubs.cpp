@@ -0,0 +1,37 @@
+// The firmware modules main.cpp calls into but no screen depends on: logging,
+// OTA, time sync, the second tick, warm-state snapshots and the dashboard.
+
+#include "log.h"
+#include "ota_update.h"
+#include "second_tick.h"
+#include "time_discipline.h"
+#include "warm_state.h"
+#include "web_dashboard.h"
+
+void log_begin() {}
+void log_flush() {}
+bool log_reserve(LogSlot *&, uint32_t &) { return false; }
+void log_commit(LogSlot *, uint32_t) {}
+void log_text(uint8_t, const char *, ...) {}
+
+OtaResult ota_check_and_apply(OtaProgressCallback) { return OTA_NO_UPDATE; }
+const char *ota_last_error() { return ""; }
+const char *ota_image_key() { return "0000000000000000"; }
+void ota_mark_healthy() {}
+
+void time_discipline_begin() {}
+bool time_discipline_update() { return false; }
+bool time_discipline_synced() { return false; }
+TimeSyncStats time_discipline_stats() { return TimeSyncStats(); }
+
+void second_tick_begin() {}
+void second_tick_rearm() {}
+bool second_tick_take(time_t &) { return false; }
+TickStats second_tick_stats() { return TickStats(); }
+
+bool warm_state_load(WarmState &) { return false; }
+void warm_state_save(const WarmState &) {}
+const char *warm_state_reset_reason() { return "host"; }
+
+void web_dashboard_begin() {}
+void web_dashboard_publish(const DashboardSnapshot &) {}
@@ -0,0 +1,84 @@
+// Host-side render regression test (env:native).
+//
+// Builds the firmware's screens against the Arduino shim in test/shim, draws
+// each one headless from the bench fixed state and compares the SSD1306
+// framebuffer byte-for-byte with test/golden/<screen>.bin. Each screen also
+// prints the render-bench BENCH line (render time on the host, pixels touched,
+// I2C bytes). The render-bench env on hardware checks the same goldens
+// (tools/render_golden.py).
+//
+// A screen with no golden yet has its frame recorded on that run and is
+// reported as ignored; commit the new file so later runs compare against it.
+//
+//   pio test -e native
+//   MEDBOX_RECORD_GOLDEN=1 pio test -e native   # accept the current frames
+
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include "../../src/main.cpp"
+#include "../../src/recurrence.cpp"
+
+static const char *golden_dir = "test/golden";
+static bool record = false;
+
+static const char *screen_name;
+static BenchRender screen_render;
+static int screen_arg;
+
+void setUp() {}
+void tearDown() {}
+
+static String golden_path() {
+  return String(golden_dir) + "/" + screen_name + ".bin";
+}
+
+static void test_screen() {
+  bench_render(screen_name, screen_render, screen_arg);
+
+  const uint8_t *frame = display.getBuffer();
+  String path = golden_path();
+
+  FILE *f = record ? NULL : fopen(path.c_str(), "rb");
+  if (f == NULL) {
+    f = fopen(path.c_str(), "wb");
+    TEST_ASSERT_NOT_NULL_MESSAGE(f, path.c_str());
+    fwrite(frame, 1, Board::frame_bytes, f);
+    fclose(f);
+    TEST_IGNORE_MESSAGE(record ? "golden recorded" : "no golden image; recorded one, commit test/golden");
+  }
+
+  static uint8_t golden[Board::frame_bytes + 1];
+  size_t len = fread(golden, 1, sizeof(golden), f);
+  fclose(f);
+
+  TEST_ASSERT_EQUAL_MESSAGE(Board::frame_bytes, len, "golden image has the wrong size");
+  TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(golden, frame, Board::frame_bytes, screen_name);
+}
+
+static void run_screen(const char *name, BenchRender render, int arg) {
+  screen_name = name;
+  screen_render = render;
+  screen_arg = arg;
+  UnityDefaultTestRun(test_screen, name, __LINE__);
+}
+
+int main(int argc, char **argv) {
+  if (getenv("MEDBOX_GOLDEN_DIR")) golden_dir = getenv("MEDBOX_GOLDEN_DIR");
+  record = getenv("MEDBOX_RECORD_GOLDEN") != NULL;
+
+  build_modes();
+  if (!display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS)) {
+    fprintf(stderr, "framebuffer allocation failed\n");
+    return 1;
+  }
+  display.headless = true;
+  mkdir(golden_dir, 0755);
+
+  UNITY_BEGIN();
+  for_each_bench_screen(run_screen);
+  return UNITY_END();
+}
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+"""Gzip web/dashboard.html into include/dashboard_html.h as a PROGMEM array.
+
+    python3 tools/embed_dashboard.py
+
+Re-run after editing the page. The output is deterministic (no gzip mtime),
+so an unchanged page produces an unchanged header.
+"""
+
+import gzip
+import os
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "web", "dashboard.html")
+TARGET = os.path.join(ROOT, "include", "dashboard_html.h")
+
+
+def main():
+    with open(SOURCE, "rb") as f:
+        html = f.read()
+    data = gzip.compress(html, compresslevel=9, mtime=0)
+
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+
+    with open(TARGET, "w") as f:
+        f.write("#pragma once\n\n")
+        f.write("// Generated by tools/embed_dashboard.py from web/dashboard.html, do not edit.\n")
+        f.write("// %d bytes of HTML, served gzipped.\n\n" % len(html))
+        f.write("const size_t dashboard_html_gz_len = %d;\n" % len(data))
+        f.write("const uint8_t dashboard_html_gz[] PROGMEM = {\n")
+        f.write("\n".join(lines) + "\n")
+        f.write("};\n")
+
+    print("%s: %d -> %d bytes" % (os.path.relpath(TARGET, ROOT), len(html), len(data)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""Decode MedBox binary logs (built with -DLOG_BINARY=1).
+
+    python3 tools/log_decode.py --port /dev/ttyUSB0      # needs pyserial
+    python3 tools/log_decode.py capture.bin
+
+Format strings are recovered by scanning the LOG_E/W/I/D calls under src/ and
+include/ and hashing them the same way as log_token() in log.h. Bytes outside
+binary frames (boot ROM output, the render bench) are passed through as text.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE_DIRS = ("src", "include")
+
+FRAME_SYNC = 0xA5
+FRAME_HEADER = 11
+TOKEN_DROPPED = 0
+LEVELS = "-EWID"
+LOG_BAUD = 921600
+
+LOG_CALL = re.compile(r'\bLOG_[EWID]\s*\(\s*"((?:[^"\\]|\\.)*)"')
+SPEC = re.compile(r"%[-+ #0]*(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l|z|j|t)?([diuxXoscpfFeEgGaA%])")
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def unescape(literal):
+    return literal.encode("latin-1").decode("unicode_escape").encode("latin-1")
+
+
+def load_formats():
+    formats = {TOKEN_DROPPED: "%u log messages dropped"}
+    for folder in SOURCE_DIRS:
+        for dirpath, _, files in os.walk(os.path.join(ROOT, folder)):
+            for name in files:
+                if not name.endswith((".cpp", ".h")):
+                    continue
+                with open(os.path.join(dirpath, name), encoding="utf-8", errors="replace") as f:
+                    for literal in LOG_CALL.findall(f.read()):
+                        raw = unescape(literal)
+                        formats[fnv1a(raw)] = raw.decode("latin-1")
+    return formats
+
+
+def render(fmt, payload):
+    """Fill fmt from the packed arguments, following log_pack() in log.h."""
+    out, pos, last = [], 0, 0
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        length, conv = m.group(3), m.group(4)
+        if conv == "%":
+            out.append("%")
+            continue
+        spec = m.group(0)
+        try:
+            if conv == "s":
+                n = payload[pos]
+                out.append(payload[pos + 1:pos + 1 + n].decode("latin-1"))
+                pos += 1 + n
+            elif conv in "fFeEgGaA":
+                (value,) = struct.unpack_from("<f", payload, pos)
+                pos += 4
+                out.append(spec % value)
+            elif length == "ll":
+                (value,) = struct.unpack_from("<q" if conv in "di" else "<Q", payload, pos)
+                pos += 8
+                out.append((spec.replace("ll", "")) % value)
+            else:
+                (value,) = struct.unpack_from("<i" if conv in "di" else "<I", payload, pos)
+                pos += 4
+                if conv == "c":
+                    out.append(chr(value & 0xFF))
+                elif conv == "p":
+                    out.append("0x%08x" % value)
+                else:
+                    spec = re.sub(r"(hh|h|l|z|j|t)(?=[diuxXo])", "", spec)
+                    if conv == "u":
+                        spec = spec[:-1] + "d"
+                    out.append(spec % value)
+        except (IndexError, struct.error):
+            out.append("<truncated>")
+            last = len(fmt)
+            break
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+class Decoder:
+    def __init__(self, formats, write):
+        self.formats = formats
+        self.write = write
+        self.buf = bytearray()
+
+    def feed(self, data):
+        buf = self.buf
+        buf += data
+        while buf:
+            start = buf.find(bytes([FRAME_SYNC]))
+            if start < 0:
+                self.write(buf.decode("latin-1"))
+                buf.clear()
+                return
+            if start > 0:
+                self.write(buf[:start].decode("latin-1"))
+                del buf[:start]
+            if len(buf) < 2 or len(buf) < buf[1] + 2:
+                return  # wait for the rest of the frame
+            frame = bytes(buf[:buf[1] + 2])
+            del buf[:len(frame)]
+            if len(frame) < FRAME_HEADER:
+                continue
+            level, token, ms = struct.unpack_from("<BII", frame, 2)
+            fmt = self.formats.get(token)
+            text = render(fmt, frame[FRAME_HEADER:]) if fmt else "<unknown token %08x>" % token
+            self.write("[%5d.%03d] %s %s\n"
+                       % (ms // 1000, ms % 1000, LEVELS[level] if level < len(LEVELS) else "?", text))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", nargs="?", help="raw capture file (default: stdin)")
+    parser.add_argument("--port", help="read live from a serial port")
+    parser.add_argument("--baud", type=int, default=LOG_BAUD)
+    args = parser.parse_args()
+
+    def write(text):
+        sys.stdout.write(text)
+        sys.stdout.flush()
+
+    decoder = Decoder(load_formats(), write)
+
+    if args.port:
+        import serial
+        port = serial.Serial(args.port, args.baud, timeout=0.1)
+        try:
+            while True:
+                decoder.feed(port.read(256))
+        except KeyboardInterrupt:
+            pass
+    else:
+        source = open(args.capture, "rb") if args.capture else sys.stdin.buffer
+        while True:
+            data = source.read(4096)
+            if not data:
+                break
+            decoder.feed(data)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Build an MBDP delta patch between two MedBox firmware images.
+
+    python3 tools/make_delta.py old.bin new.bin out
+
+old.bin must be the exact image running on the device (the device checks its
+CRC before applying). The patch is written to out/medbox-<key>.mbdp, where the
+key is the first 8 bytes of old.bin's ELF SHA-256 in hex: the name the device
+running old.bin asks for. Serve the output directory with any HTTP server, e.g.
+`python3 -m http.server 8000 --directory out`, and point OTA_SERVER at it.
+Use --full to emit a patch that does not reference the old image at all.
+
+The ops are deflated (format version 2) unless --raw is given. Devices still
+running firmware from before compressed patches only accept --raw (version 1).
+Firmware from before patches were named by key asks for medbox-1.0.0.mbdp;
+rename the output for those devices.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b"MBDP"
+
+# esp_app_desc_t follows the image header (24 bytes) and the first segment
+# header (8 bytes); app_elf_sha256 is 144 bytes into it
+APP_DESC_OFFSET = 32
+APP_DESC_MAGIC = 0xABCD5432
+APP_ELF_SHA256_OFFSET = APP_DESC_OFFSET + 144
+VERSION_RAW = 1
+VERSION_DEFLATE = 2
+
+OP_END = 0
+OP_COPY = 1
+OP_INSERT = 2
+OP_FILL = 3
+
+BLOCK = 16      # minimum match length worth a COPY
+MIN_FILL = 8    # minimum run length worth a FILL
+MAX_CANDIDATES = 8
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        b = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def image_key(image):
+    """Name of the patch a device running this image asks for."""
+    magic, = struct.unpack_from("<I", image, APP_DESC_OFFSET)
+    if magic != APP_DESC_MAGIC:
+        sys.exit("old image has no app description; is it an ESP32 app .bin?")
+    return image[APP_ELF_SHA256_OFFSET:APP_ELF_SHA256_OFFSET + 8].hex()
+
+
+def index_source(old):
+    index = {}
+    for i in range(0, len(old) - BLOCK + 1):
+        key = old[i:i + BLOCK]
+        slots = index.setdefault(key, [])
+        if len(slots) < MAX_CANDIDATES:
+            slots.append(i)
+    return index
+
+
+def match_length(old, src, new, dst):
+    n = 0
+    limit = min(len(old) - src, len(new) - dst)
+    while n < limit and old[src + n] == new[dst + n]:
+        n += 1
+    return n
+
+
+def run_length(data, pos):
+    n = 1
+    while pos + n < len(data) and data[pos + n] == data[pos]:
+        n += 1
+    return n
+
+
+class PatchWriter:
+    def __init__(self):
+        self.out = bytearray()
+        self.literal = bytearray()
+
+    def flush_literal(self):
+        if self.literal:
+            self.out += bytes([OP_INSERT]) + varint(len(self.literal)) + self.literal
+            self.literal = bytearray()
+
+    def copy(self, offset, length):
+        self.flush_literal()
+        self.out += bytes([OP_COPY]) + varint(offset) + varint(length)
+
+    def fill(self, value, length):
+        self.flush_literal()
+        self.out += bytes([OP_FILL]) + varint(length) + bytes([value])
+
+    def finish(self):
+        self.flush_literal()
+        self.out.append(OP_END)
+        return bytes(self.out)
+
+
+def diff(old, new, full):
+    index = {} if full else index_source(old)
+    writer = PatchWriter()
+    pos = 0
+    next_src = 0  # continuing the previous COPY is the common case
+
+    while pos < len(new):
+        best_src, best_len = -1, 0
+
+        if not full:
+            length = match_length(old, next_src, new, pos) if next_src < len(old) else 0
+            if length >= BLOCK:
+                best_src, best_len = next_src, length
+            else:
+                for src in index.get(new[pos:pos + BLOCK], ()):
+                    length = match_length(old, src, new, pos)
+                    if length > best_len:
+                        best_src, best_len = src, length
+
+        if best_len >= BLOCK:
+            writer.copy(best_src, best_len)
+            pos += best_len
+            next_src = best_src + best_len
+            continue
+
+        run = run_length(new, pos)
+        if run >= MIN_FILL:
+            writer.fill(new[pos], run)
+            pos += run
+            continue
+
+        writer.literal.append(new[pos])
+        pos += 1
+
+    return writer.finish()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("old", help="image currently running on the device")
+    parser.add_argument("new", help="image to install")
+    parser.add_argument("out", help="directory to write medbox-<key>.mbdp to")
+    parser.add_argument("--full", action="store_true", help="do not reference the old image")
+    parser.add_argument("--raw", action="store_true", help="do not deflate the ops (version 1)")
+    args = parser.parse_args()
+
+    with open(args.old, "rb") as f:
+        old = f.read()
+    with open(args.new, "rb") as f:
+        new = f.read()
+
+    patch = os.path.join(args.out, "medbox-%s.mbdp" % image_key(old))
+    ops = diff(old, new, args.full)
+    body = ops if args.raw else zlib.compress(ops, 9)
+
+    header = MAGIC + struct.pack("<B3xIIII", VERSION_RAW if args.raw else VERSION_DEFLATE,
+                                 len(old), zlib.crc32(old),
+                                 len(new), zlib.crc32(new))
+
+    os.makedirs(args.out, exist_ok=True)
+    with open(patch, "wb") as f:
+        f.write(header + body)
+
+    print("%s: %d bytes for a %d byte image (%.1f%%)"
+          % (patch, len(header) + len(body), len(new),
+             100.0 * (len(header) + len(body)) / len(new)))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
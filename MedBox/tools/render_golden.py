@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Check render-bench output against golden framebuffers.
+
+    pio run -e render-bench -t upload
+    pio device monitor -e render-bench | python3 tools/render_golden.py
+    python3 tools/render_golden.py bench.log --record   # accept current frames
+
+Reads the BENCH/FRAME lines printed by env:render-bench (from a file or
+stdin), compares every frame byte-for-byte with test/golden/<screen>.bin and
+prints the per-screen cost table. Exits non-zero if any frame differs or has
+no golden image. The goldens are shared with the host-side render test
+(pio test -e native), which is where they are normally recorded.
+"""
+
+import argparse
+import os
+import sys
+
+GOLDEN_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "test", "golden")
+
+
+def parse(lines):
+    stats, frames = {}, {}
+    for line in lines:
+        line = line.strip()
+        if line == "BENCH end":
+            break
+        if line.startswith("BENCH ") and "=" in line:
+            parts = line.split()
+            stats[parts[1]] = dict(p.split("=", 1) for p in parts[2:])
+        elif line.startswith("FRAME "):
+            _, name, data = line.split(" ", 2)
+            frames[name] = bytes.fromhex(data)
+    return stats, frames
+
+
+def first_difference(a, b):
+    for i, (x, y) in enumerate(zip(a, b)):
+        if x != y:
+            return i
+    return min(len(a), len(b))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", help="captured serial output (default: stdin)")
+    parser.add_argument("--record", action="store_true", help="write frames as the new goldens")
+    parser.add_argument("--golden-dir", default=GOLDEN_DIR)
+    args = parser.parse_args()
+
+    source = open(args.log) if args.log else sys.stdin
+    stats, frames = parse(source)
+    if not frames:
+        print("no FRAME lines found", file=sys.stderr)
+        return 2
+
+    os.makedirs(args.golden_dir, exist_ok=True)
+    failures = 0
+
+    print("%-16s %9s %5s %7s %7s %9s %7s  %s"
+          % ("screen", "render_us", "lit", "changed", "flushes", "i2c_bytes", "i2c_us", "golden"))
+    for name, frame in frames.items():
+        path = os.path.join(args.golden_dir, name + ".bin")
+
+        if args.record:
+            with open(path, "wb") as f:
+                f.write(frame)
+            verdict = "recorded"
+        elif not os.path.exists(path):
+            verdict = "MISSING"
+            failures += 1
+        else:
+            with open(path, "rb") as f:
+                golden = f.read()
+            if golden == frame:
+                verdict = "ok"
+            else:
+                diff = sum(1 for x, y in zip(golden, frame) if x != y) + abs(len(golden) - len(frame))
+                verdict = "DIFF %d bytes, first at %d" % (diff, first_difference(golden, frame))
+                failures += 1
+
+        s = stats.get(name, {})
+        print("%-16s %9s %5s %7s %7s %9s %7s  %s"
+              % (name, s.get("render_us", "?"), s.get("lit", "?"), s.get("changed", "?"),
+                 s.get("flushes", "?"), s.get("i2c_bytes", "?"), s.get("i2c_us", "?"), verdict))
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())